@@ -41,9 +41,11 @@
 #include <cstdint>
 #include <cstring>
 #include <exception>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 //
 #if SERIO_CPP_VERSION >= 201703L
 #include <string_view>
@@ -58,6 +60,15 @@
 #endif
 #endif
 
+#if SERIO_CPP_VERSION >= 201703L && __has_include(<memory_resource>)
+#include <memory_resource>
+#if defined(__cpp_lib_memory_resource)
+/// Defined when `<memory_resource>` is available. When defined, binary deserialization can take
+/// the memory of the objects it creates from a `std::pmr::memory_resource`.
+#define SERIO_ENABLE_PMR 1
+#endif
+#endif
+
 #ifdef _WIN32
 /// Expands to `__declspec(dllexport)` on Windows so that symbols in a shared-library build are
 /// exported. On all other platforms it expands to nothing.
@@ -79,7 +90,22 @@
     friend class Serio::Impl::JsonSerializer;   \
     friend class Serio::Impl::JsonDeserializer; \
     friend class Serio::Impl::XmlSerializer;    \
-    friend class Serio::Impl::XmlDeserializer;
+    friend class Serio::Impl::XmlDeserializer;  \
+    friend struct Serio::Impl::Access;
+
+#if SERIO_CPP_VERSION >= 201402L
+/// Declares `_members()`, whose return type lists the types of the registered members. It is only
+/// ever used in unevaluated context. Requires return type deduction, so it expands to nothing
+/// before C++14.
+#define SERIO_MEMBERS(...)                           \
+    template <typename _T = void>                    \
+    auto _members() const                            \
+    {                                                \
+        return Serio::Impl::memberList(__VA_ARGS__); \
+    }
+#else
+#define SERIO_MEMBERS(...)
+#endif
 
 /// Registers a class for serialization by generating `_serialize` and `_deserialize` template
 /// methods and the necessary friend declarations. Place this macro in the body of the class you
@@ -100,8 +126,11 @@
 /// compatibility.
 ///
 /// Internally this macro also expands `SERIO_FRIEND` so private members are always accessible.
+/// On C++14 and later it also records the member types through `SERIO_MEMBERS`, which lets the
+/// binary backend size structs made only of fixed-size members at compile time.
 #define SERIO_REGISTER(...)              \
     SERIO_FRIEND                         \
+    SERIO_MEMBERS(__VA_ARGS__)           \
                                          \
     template <typename Serializer>       \
     void _serialize(Serializer& C) const \
@@ -132,6 +161,10 @@
 #define SERIO_UNIX
 #endif
 
+#ifdef SERIO_UNIX
+#include <sys/uio.h>
+#endif
+
 /// Evaluates `expr` and, if it is false, throws `Serio::Exception` with a message that includes
 /// the source file name, line number, enclosing function signature, and the user-supplied `msg`
 /// string. This macro is used pervasively inside the library to validate invariants during
@@ -157,6 +190,14 @@ namespace Serio
 /// can be read on 64-bit ones and vice versa.
 using Size = std::uint64_t;
 
+#if SERIO_ENABLE_PMR
+/// The type `DeserializeOptions::memoryResource` points to.
+using MemoryResource = std::pmr::memory_resource;
+#else
+/// Stands in for `std::pmr::memory_resource` where the standard library lacks it; never defined.
+struct MemoryResource;
+#endif
+
 /// The exception type thrown by `SERIO_ASSERT`. Every runtime error the library detects —
 /// malformed binary data, version mismatches, type mismatches in JSON/XML, failed file I/O,
 /// CRC check failures, etc. — is reported through this type. Catch `Serio::Exception` (or its
@@ -185,10 +226,11 @@ struct Exception : std::exception
 /// interface (`data()`, `begin()`, `end()`) is const-only; mutation goes through `operator[]` or
 /// directly via the `ptr` member.
 ///
-/// Deserializing into a `PointerView` is intentionally unsupported: the view has no mechanism to
-/// resize or reallocate memory, so a compile-time `static_assert` is triggered if you attempt it.
-/// Use `StaticArrayView` instead when the buffer already exists and its size is known at compile
-/// time, or a `std::vector` when you need the deserialization to allocate memory.
+/// A `PointerView` has no mechanism to resize or reallocate memory, so it can't be deserialized
+/// into. The one exception is a view of const elements with `DeserializeOptions::zeroCopy` set, which
+/// is bound to the elements in place inside the input buffer. Otherwise use `StaticArrayView` when
+/// the buffer already exists and its size is known at compile time, or a `std::vector` when you
+/// need the deserialization to allocate memory.
 ///
 /// @tparam T  Element type. Must be arithmetic for the fast bulk-copy path to be used.
 template <typename T>
@@ -334,6 +376,287 @@ struct StringView
     }
 };
 
+/// A growable, contiguous byte buffer used as an output target by the binary serializer. Unlike
+/// `std::string`, growing the buffer never zero-fills the new bytes: `take()` and `resize()` hand
+/// out uninitialized space that the serializer overwrites immediately. Capacity grows
+/// geometrically, so appending many small fields costs amortized constant time.
+///
+/// The allocator is pluggable, which lets large payloads be placed in huge-page backed or pooled
+/// memory. It must allocate `char` and follows the usual `std::allocator_traits` protocol,
+/// including allocator propagation on copy, move, and swap.
+///
+/// @tparam Allocator  An allocator whose `value_type` is `char`. Defaults to `std::allocator<char>`.
+template <typename Allocator = std::allocator<char>>
+class BasicBuffer
+{
+    using Traits = std::allocator_traits<Allocator>;
+    static_assert(std::is_same<typename Traits::value_type, char>::value, "Buffer allocator must allocate char.");
+
+    Allocator _allocator;
+    char* _data{nullptr};
+    Size _size{0};
+    Size _capacity{0};
+
+    void deallocate()
+    {
+        if (_data) Traits::deallocate(_allocator, _data, _capacity);
+        _data = nullptr;
+        _size = _capacity = 0;
+    }
+    void adopt(Allocator& allocator, std::true_type) { _allocator = std::move(allocator); }
+    void adopt(Allocator&, std::false_type) {}
+    void exchange(BasicBuffer& other, std::true_type)
+    {
+        using std::swap;
+        swap(_allocator, other._allocator);
+    }
+    void exchange(BasicBuffer&, std::false_type) {}
+    void grow(Size minimum)
+    {
+        Size capacity = _capacity * 2;
+        if (capacity < minimum) capacity = minimum;
+        if (capacity < 64) capacity = 64;
+        reserve(capacity);
+    }
+
+public:
+    using allocator_type = Allocator;
+
+    /// Constructs an empty buffer. No memory is allocated until the first write.
+    BasicBuffer() = default;
+
+    /// Constructs an empty buffer that allocates through a copy of `allocator`.
+    explicit BasicBuffer(const Allocator& allocator) : _allocator(allocator) {}
+
+    /// Copies the contents of `other`. The allocator is obtained through
+    /// `select_on_container_copy_construction`.
+    BasicBuffer(const BasicBuffer& other)
+        : _allocator(Traits::select_on_container_copy_construction(other._allocator))
+    {
+        append(other._data, other._size);
+    }
+
+    /// Takes over the storage of `other`, leaving it empty.
+    BasicBuffer(BasicBuffer&& other) noexcept
+        : _allocator(std::move(other._allocator)), _data(other._data), _size(other._size), _capacity(other._capacity)
+    {
+        other._data = nullptr;
+        other._size = other._capacity = 0;
+    }
+
+    /// Replaces the contents with a copy of `other`.
+    BasicBuffer& operator=(const BasicBuffer& other)
+    {
+        if (this == &other) return *this;
+        if (Traits::propagate_on_container_copy_assignment::value && _allocator != other._allocator)
+        {
+            deallocate();
+            Allocator allocator(other._allocator);
+            adopt(allocator, typename Traits::propagate_on_container_copy_assignment());
+        }
+        _size = 0;
+        append(other._data, other._size);
+        return *this;
+    }
+
+    /// Replaces the contents with those of `other`, leaving `other` empty. The storage is taken
+    /// over when the allocators allow it and copied otherwise.
+    BasicBuffer& operator=(BasicBuffer&& other)
+    {
+        if (this == &other) return *this;
+        if (Traits::propagate_on_container_move_assignment::value || _allocator == other._allocator)
+        {
+            deallocate();
+            adopt(other._allocator, typename Traits::propagate_on_container_move_assignment());
+            std::swap(_data, other._data);
+            std::swap(_size, other._size);
+            std::swap(_capacity, other._capacity);
+        }
+        else
+        {
+            _size = 0;
+            append(other._data, other._size);
+            other.deallocate();
+        }
+        return *this;
+    }
+
+    ~BasicBuffer() { deallocate(); }
+
+    /// Exchanges the contents (and, if the allocator propagates on swap, the allocators) of two
+    /// buffers without copying any bytes.
+    void swap(BasicBuffer& other) noexcept
+    {
+        exchange(other, typename Traits::propagate_on_container_swap());
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+    /// Returns a pointer to the first byte, or null if nothing has been allocated yet.
+    char* data() { return _data; }
+
+    /// Returns a const pointer to the first byte, or null if nothing has been allocated yet.
+    const char* data() const { return _data; }
+
+    /// Returns the number of bytes written so far.
+    Size size() const { return _size; }
+
+    /// Returns the number of bytes that can be held before the buffer has to reallocate.
+    Size capacity() const { return _capacity; }
+
+    /// Returns true when the buffer holds no bytes.
+    bool empty() const { return _size == 0; }
+
+    /// Returns a copy of the allocator used by this buffer.
+    Allocator get_allocator() const { return _allocator; }
+
+    /// Returns a view over the bytes written so far. The view is invalidated by any operation that
+    /// grows the buffer.
+    StringView view() const { return StringView(_data, _size); }
+
+    /// Ensures that at least `capacity` bytes can be held without reallocating. Never shrinks.
+    void reserve(Size capacity)
+    {
+        if (capacity <= _capacity) return;
+        char* data = Traits::allocate(_allocator, capacity);
+        if (_size > 0) std::memcpy(data, _data, _size);
+        if (_data) Traits::deallocate(_allocator, _data, _capacity);
+        _data = data;
+        _capacity = capacity;
+    }
+
+    /// Sets the size to `size`. Bytes added by growing the buffer are left uninitialized.
+    void resize(Size size)
+    {
+        if (size > _capacity) grow(size);
+        _size = size;
+    }
+
+    /// Discards the contents but keeps the allocated capacity for reuse.
+    void clear() { _size = 0; }
+
+    /// Releases all memory held by the buffer.
+    void reset() { deallocate(); }
+
+    /// Extends the buffer by `size` uninitialized bytes and returns a pointer to the first of them.
+    /// The pointer stays valid until the buffer grows again.
+    char* take(Size size)
+    {
+        if (_size + size > _capacity) grow(_size + size);
+        char* ptr = _data + _size;
+        _size += size;
+        return ptr;
+    }
+
+    /// Appends `size` bytes copied from `data`.
+    void append(const void* data, Size size)
+    {
+        if (size > 0) std::memcpy(take(size), data, size);
+    }
+};
+
+/// The default growable byte buffer, backed by `std::allocator<char>`.
+using Buffer = BasicBuffer<>;
+
+/// One contiguous piece of scatter-gather output.
+struct Segment
+{
+    const char* data;
+    Size size;
+};
+
+/// Scatter-gather output for the binary serializer. Small fields are copied into an internal
+/// staging buffer, while continuous blocks of at least `threshold()` bytes (strings and vectors of
+/// arithmetic or trivially serializable types) are recorded as references into the serialized
+/// objects themselves. The resulting list of segments can be handed to `writev()` or `sendmsg()`,
+/// so large payloads reach the file descriptor without an intermediate copy.
+///
+/// Referenced blocks are not owned: the serialized values must stay alive and unchanged until the
+/// segments have been consumed. A `CustomClass` that serializes a temporary string or container
+/// larger than the threshold would leave a dangling reference, so lower the threshold with care.
+class Segments
+{
+    struct Piece
+    {
+        const char* data;  // null for bytes in the staging buffer
+        Size offset;
+        Size size;
+    };
+
+    Buffer _staging;
+    std::vector<Piece> _pieces;
+    Size _threshold;
+    Size _size{0};
+
+public:
+    /// Constructs an empty list that references blocks of `threshold` bytes or more.
+    explicit Segments(Size threshold = 4096) : _threshold(threshold) {}
+
+    /// Returns the size from which continuous blocks are referenced instead of copied.
+    Size threshold() const { return _threshold; }
+
+    /// Returns the total number of bytes across all segments.
+    Size size() const { return _size; }
+
+    /// Returns the number of segments.
+    Size count() const { return _pieces.size(); }
+
+    /// Returns the bytes copied so far. Segments that were not referenced point into it.
+    Buffer& staging() { return _staging; }
+
+    /// Discards all segments but keeps the staging capacity for reuse.
+    void clear()
+    {
+        _staging.clear();
+        _pieces.clear();
+        _size = 0;
+    }
+
+    /// Reserves `size` uninitialized bytes at the end of the staging buffer and returns a pointer
+    /// to them. The pointer stays valid until the staging buffer grows again.
+    char* take(Size size)
+    {
+        if (_pieces.empty() || _pieces.back().data) _pieces.push_back({nullptr, _staging.size(), 0});
+        _pieces.back().size += size;
+        _size += size;
+        return _staging.take(size);
+    }
+
+    /// Appends `size` bytes from `data`, as a reference when `size` reaches the threshold and as a
+    /// copy otherwise.
+    void append(const void* data, Size size)
+    {
+        if (size == 0) return;
+        if (size < _threshold) return (void)std::memcpy(take(size), data, size);
+        _pieces.push_back({(const char*)data, 0, size});
+        _size += size;
+    }
+
+    /// Returns the segments in order. The result is invalidated by any further append.
+    std::vector<Segment> segments() const
+    {
+        std::vector<Segment> output;
+        output.reserve(_pieces.size());
+        for (const auto& piece : _pieces)
+            output.push_back({piece.data ? piece.data : _staging.data() + piece.offset, piece.size});
+        return output;
+    }
+
+#ifdef SERIO_UNIX
+    /// Returns the segments as `iovec`s, ready for `writev()` or `sendmsg()`. Callers must split
+    /// lists longer than `IOV_MAX` themselves. The result is invalidated by any further append.
+    std::vector<iovec> iovecs() const
+    {
+        std::vector<iovec> output;
+        output.reserve(_pieces.size());
+        for (const auto& piece : _pieces)
+            output.push_back({(void*)(piece.data ? piece.data : _staging.data() + piece.offset), piece.size});
+        return output;
+    }
+#endif
+};
+
 /// The primary extension point for registering types that are not owned by you — types from
 /// third-party libraries or system headers — for serialization without modifying them. When the
 /// serializer encounters a class type `T` that is not handled by any built-in rule, it
@@ -367,6 +690,10 @@ struct StringView
 template <typename T, class Enable = void>
 struct CustomClass
 {
+    /// Only present on this default implementation. Tells the binary backend that `T` is
+    /// serialized through its `SERIO_REGISTER` member list, which it may then inspect.
+    using Registered = void;
+
     /// Calls `value._serialize(C)`, which is generated by `SERIO_REGISTER` inside the class body.
     template <typename Serializer>
     void serialize(const T& value, Serializer& C)
@@ -382,6 +709,97 @@ struct CustomClass
     }
 };
 
+/// Opt-in trait declaring that the in-memory bytes of `T` are exactly its binary encoding on a
+/// little-endian host: no padding, members in the order they are serialized, and no members that
+/// need encoding of their own (pointers, containers, strings). Contiguous containers of such types
+/// (`std::vector`, `std::array`, views and spans) are then written and read with a single copy.
+/// Big-endian hosts fall back to element-by-element serialization, so `T` must still be
+/// serializable the usual way, through `SERIO_REGISTER` or a `CustomClass` specialization.
+///
+/// Enums and `std::complex` of arithmetic types are trivially serializable by default. Specialize
+/// this template, or use `SERIO_TRIVIAL`, to opt your own types in:
+/// @code
+/// struct Tick {
+///     int64_t time;
+///     double price;
+///     SERIO_REGISTER(time, price)
+/// };
+/// SERIO_TRIVIAL(Tick)
+/// @endcode
+///
+/// The wire format does not change, so data written either way can be read either way.
+///
+/// @tparam T       The type to mark.
+/// @tparam Enable  Unused by the default; reserved for SFINAE-based partial specializations.
+template <typename T, class Enable = void>
+struct IsTriviallySerializable : std::integral_constant<bool, std::is_enum<T>::value>
+{
+};
+
+/// Specializes `Serio::IsTriviallySerializable` for the given type. Use it at global namespace
+/// scope, after the type is defined.
+#define SERIO_TRIVIAL(...)                                                \
+    namespace Serio                                                       \
+    {                                                                     \
+    template <>                                                           \
+    struct IsTriviallySerializable<__VA_ARGS__> : std::true_type          \
+    {                                                                     \
+    };                                                                    \
+    }
+
+/// The classes listed by a `PolymorphicTypes` specialization, in the order of their ids.
+template <typename... Ts>
+struct DerivedTypes
+{
+};
+
+/// Lists the classes derived from the polymorphic class `T` that `std::unique_ptr<T>` and
+/// `std::shared_ptr<T>` may point to when they are written in binary form. Each class gets its
+/// position in the list as a compact id, which is written ahead of the object, and the object is
+/// read back through a table of constructors indexed by that id. Objects of classes that aren't
+/// listed throw `Serio::Exception` when written. Classes are written with their own registration,
+/// which must include that of `T` if its members are to be written too.
+///
+/// The ids are part of the data, so append new classes to the end of the list and never remove or
+/// reorder the ones already there. List `T` itself if objects of exactly `T` are written. Use
+/// `SERIO_POLYMORPHIC` to specialize this template:
+/// @code
+/// struct Shape {
+///     virtual ~Shape() = default;
+///     std::string name;
+///     SERIO_REGISTER(name)
+/// };
+/// struct Circle : Shape {
+///     double radius;
+///     SERIO_REGISTER(name, radius)
+/// };
+/// struct Square : Shape {
+///     double side;
+///     SERIO_REGISTER(name, side)
+/// };
+/// SERIO_POLYMORPHIC(Shape, Circle, Square)
+/// @endcode
+///
+/// @tparam T       The base class.
+/// @tparam Enable  Unused by the default; reserved for SFINAE-based partial specializations.
+template <typename T, class Enable = void>
+struct PolymorphicTypes
+{
+};
+
+/// Specializes `Serio::PolymorphicTypes` for the base class `Class`, giving the classes that follow
+/// it their ids in order. Use it at global namespace scope, after the classes are defined. A base
+/// class whose name has commas in it needs an alias.
+#define SERIO_POLYMORPHIC(Class, ...)            \
+    namespace Serio                              \
+    {                                            \
+    template <>                                  \
+    struct PolymorphicTypes<Class>               \
+    {                                            \
+        using Types = DerivedTypes<__VA_ARGS__>; \
+    };                                           \
+    }
+
 /// A tag wrapper that instructs the serializer to treat the contained string value as opaque
 /// binary data rather than human-readable text. In the binary backend this has no visible effect
 /// because all strings are already stored as raw bytes. In the JSON and XML backends, however,
@@ -421,6 +839,60 @@ BinaryString<T&> binaryString(T& value)
     return BinaryString<T&>{value};
 }
 
+/// A tag wrapper that makes the binary backend store a `std::vector` together with a table of the
+/// byte offsets of its elements, so that an `IndexedView` can later decode any element, or any
+/// range of them, straight from the buffer without decoding the elements in front. The table
+/// costs 8 bytes per element and a sizing pass over the elements when writing; it pays off for
+/// large vectors of variable-size elements, such as records with strings, that are read a window
+/// at a time. In the JSON and XML backends the vector is written as usual.
+///
+/// Do not construct this directly; use the `indexed()` helper instead.
+///
+/// @tparam T  Either `const std::vector<...>&` or `std::vector<...>&`, bound by `indexed()`.
+template <typename T>
+struct Indexed
+{
+    /// The wrapped vector. `T` is a reference type so no copy is made.
+    T value;
+};
+
+/// Creates an `Indexed` wrapper around a const vector, so that it is serialized with an offset
+/// table in the binary backend.
+template <typename T>
+Indexed<const T&> indexed(const T& value)
+{
+    return Indexed<const T&>{value};
+}
+
+/// Creates an `Indexed` wrapper around a mutable vector, used on the deserialization side to read
+/// a vector written through `indexed()` back in full, skipping its offset table.
+template <typename T>
+Indexed<T&> indexed(T& value)
+{
+    return Indexed<T&>{value};
+}
+
+/// A placeholder that makes deserialization move past a serialized `T` without constructing it,
+/// so that a value further along can be read without decoding, or allocating for, the ones in
+/// front. Strings and containers of fixed-size elements are stepped over at once using their
+/// length prefixes. In the JSON and XML backends the next item is passed over.
+///
+/// Do not construct this directly; use the `skip()` helper instead.
+///
+/// @tparam T  The type the value was serialized as.
+template <typename T>
+struct Skip
+{
+};
+
+/// Creates a `Skip` placeholder for a value serialized as `T`, to pass to `deserialize` in its
+/// place.
+template <typename T>
+Skip<T> skip()
+{
+    return Skip<T>{};
+}
+
 /// A Name-Value Pair that associates a string key with a value reference. When the JSON or
 /// XML serializer encounters an `NVP`, it writes the value as a named field in a JSON object or
 /// as an XML element with a tag equal to the name, rather than as a positional array element.
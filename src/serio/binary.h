@@ -46,6 +46,8 @@
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <typeindex>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 //
@@ -64,451 +66,2258 @@
 
 namespace Serio
 {
+template <typename T>
+struct IsTriviallySerializable<std::complex<T>> : std::is_arithmetic<T>
+{
+};
+
+/// A view of a vector of `T` written through `indexed()`, filled by binary deserialization in
+/// zero-copy mode (`DeserializeOptions::zeroCopy`). Binding it reads only the element count and
+/// moves past the vector; `read()`, `at()` and `range()` then decode single elements or ranges of
+/// them, found through the offset table, without decoding the elements in front. Like the other
+/// views it points into the input, so keep the buffer or `FileMapping` alive while using it.
+template <typename T>
+class IndexedView
+{
+public:
+    /// Decodes `count` elements stored in `[data, data + size)` into `values`.
+    using Reader = void (*)(const char* data, Size size, Size maxLength, T* values, Size count);
+
+private:
+    const char* _table{nullptr};
+    const char* _items{nullptr};
+    Size _count{0};
+    Size _maxLength{0};
+    Reader _reader{nullptr};
+
+    Size offset(Size index) const
+    {
+        Size value = 0;
+        Impl::BasicType::deserialize(_table + index * sizeof(Size), value);
+        return value;
+    }
+
+public:
+    /// Constructs an empty view.
+    IndexedView() = default;
+
+    /// Views the `count` elements that start at `items`, whose `count + 1` offsets are at `table`.
+    IndexedView(const char* table, const char* items, Size count, Size maxLength, Reader reader)
+        : _table(table), _items(items), _count(count), _maxLength(maxLength), _reader(reader)
+    {
+    }
+
+    Size size() const { return _count; }
+    bool empty() const { return _count == 0; }
+
+    /// Decodes the elements in `[begin, end)` into `values`. Throws `Serio::Exception` when the range
+    /// is out of bounds.
+    void read(Size begin, Size end, T* values) const
+    {
+        SERIO_ASSERT(begin <= end && end <= _count, "Range is out of bounds");
+        Size first = offset(begin), last = offset(end);
+        SERIO_ASSERT(first <= last && last <= offset(_count), "Offset table doesn't match the input buffer");
+        _reader(_items + first, last - first, _maxLength, values, end - begin);
+    }
+
+    /// Decodes the element at `index`.
+    T at(Size index) const
+    {
+        T value;
+        read(index, index + 1, &value);
+        return value;
+    }
+
+    /// Decodes the elements in `[begin, end)`.
+    std::vector<T> range(Size begin, Size end) const
+    {
+        std::vector<T> values(begin <= end ? end - begin : 0);
+        read(begin, end, values.data());
+        return values;
+    }
+};
+
 namespace Impl
 {
-template <typename Derived>
+/// Type list returned (never called) by the `_members()` method that `SERIO_REGISTER` declares.
+template <typename... Ts>
+struct Members
+{
+};
+
+template <typename... Ts>
+Members<typename std::decay<Ts>::type...> memberList(const Ts&...)
+{
+    return {};
+}
+
+/// Befriended by `SERIO_FRIEND` so that traits can look at the registered members of a class.
+struct Access
+{
+    template <typename T>
+    static auto members(const T& value) -> decltype(value.template _members<>());
+};
+
+template <typename... Ts>
+struct Void
+{
+    using Type = void;
+};
+
+template <typename T, class Enable = void>
+struct IsRegistered : std::false_type
+{
+};
+template <typename T>
+struct IsRegistered<
+    T, typename Void<decltype(Access::members(std::declval<const T&>())), typename CustomClass<T>::Registered>::Type>
+    : std::true_type
+{
+};
+
+/// True when the container `T` can set aside room for a number of elements, as unordered
+/// containers and flat maps can.
+template <typename T, class Enable = void>
+struct HasReserve : std::false_type
+{
+};
+template <typename T>
+struct HasReserve<T, typename Void<decltype(std::declval<T&>().reserve(Size()))>::Type> : std::true_type
+{
+};
+
+/// True when elements can be taken out of the associative container `T` as node handles.
+template <typename T, class Enable = void>
+struct HasExtract : std::false_type
+{
+};
+template <typename T>
+struct HasExtract<T, typename Void<decltype(std::declval<T&>().extract(std::declval<T&>().begin()))>::Type>
+    : std::true_type
+{
+};
+
+/// True when `T` takes its memory from a `std::pmr::memory_resource`, as the `std::pmr` containers
+/// and strings do.
+#if SERIO_ENABLE_PMR
+template <typename T>
+struct UsesResource : std::uses_allocator<T, std::pmr::polymorphic_allocator<char>>
+{
+};
+#else
+template <typename T>
+struct UsesResource : std::false_type
+{
+};
+#endif
+
+/// True when the associative container `T` maps keys to values, which `ValueType` tells apart by
+/// a key that isn't const.
+template <typename T>
+struct IsMap : std::integral_constant<bool, !std::is_same<typename ValueType<T>::Type, typename T::value_type>::value>
+{
+};
+
+/// True when `T` is a base class whose derived classes are listed by `SERIO_POLYMORPHIC`.
+template <typename T, class Enable = void>
+struct HasDerived : std::false_type
+{
+};
+template <typename T>
+struct HasDerived<T, typename Void<typename PolymorphicTypes<T>::Types>::Type> : std::true_type
+{
+};
+
+/// The id of the class of `value` among those listed as derived from `T`. The ids are hashed by
+/// type on first use, so finding one takes the same time however many classes there are.
+template <typename T, typename... Ts>
+Size derivedId(const T& value, DerivedTypes<Ts...>)
+{
+    static_assert(std::is_polymorphic<T>::value, "Classes with derived classes listed must be polymorphic.");
+    static const std::unordered_map<std::type_index, Size> ids = [] {
+        const std::type_index types[] = {typeid(Ts)...};
+        std::unordered_map<std::type_index, Size> table;
+        for (Size i = 0; i < sizeof...(Ts); ++i) table.emplace(types[i], i);
+        return table;
+    }();
+
+    auto it = ids.find(typeid(value));
+    SERIO_ASSERT(it != ids.end(), "Class of the object isn't listed as derived from the pointer type");
+    return it->second;
+}
+
+/// The registered members of `T`, as a `Members` list.
+template <typename T>
+using MembersOf = decltype(Access::members(std::declval<const T&>()));
+
+template <typename T>
+struct MemberCount;
+template <typename... Ts>
+struct MemberCount<Members<Ts...>> : std::integral_constant<Size, sizeof...(Ts)>
+{
+};
+
+/// Type of the registered member at `I` in the `Members` list `T`.
+template <typename T, Size I>
+struct MemberAt;
+template <typename T, typename... Ts>
+struct MemberAt<Members<T, Ts...>, 0>
+{
+    using Type = T;
+};
+template <typename T, typename... Ts, Size I>
+struct MemberAt<Members<T, Ts...>, I> : MemberAt<Members<Ts...>, I - 1>
+{
+};
+
+/// Number of bytes `T` always occupies in the binary format, or zero when that depends on the
+/// value. Arithmetic types, enums, `std::array`, `std::pair`, `std::tuple`, `std::complex`,
+/// `std::bitset`, `std::chrono` types and classes whose `SERIO_REGISTER` members are all
+/// fixed-size have a fixed size.
+template <typename T, class Enable = void>
+struct WireSize : std::integral_constant<Size, 0>
+{
+};
+
+template <typename... Ts>
+struct WireSum : std::integral_constant<Size, 0>
+{
+};
+template <typename T, typename... Ts>
+struct WireSum<T, Ts...>
+    : std::integral_constant<Size, (WireSize<T>::value == 0 || (sizeof...(Ts) > 0 && WireSum<Ts...>::value == 0))
+                                       ? 0
+                                       : WireSize<T>::value + WireSum<Ts...>::value>
+{
+};
+
+template <typename T>
+struct WireSize<T, EnableIfT<std::is_arithmetic<T>::value || std::is_enum<T>::value>>
+    : std::integral_constant<Size, sizeof(T)>
+{
+};
+template <typename T>
+struct WireSize<T, EnableIfT<IsRegistered<T>::value>>
+    : WireSize<decltype(Access::members(std::declval<const T&>()))>
+{
+};
+template <typename... Ts>
+struct WireSize<Members<Ts...>> : WireSum<Ts...>
+{
+};
+
+/// Number of bytes in front of member `I` of the fixed-size `Members` list `T`.
+template <typename T, Size I>
+struct WireOffset;
+template <typename T, typename... Ts>
+struct WireOffset<Members<T, Ts...>, 0> : std::integral_constant<Size, 0>
+{
+};
+template <typename T, typename... Ts, Size I>
+struct WireOffset<Members<T, Ts...>, I>
+    : std::integral_constant<Size, WireSize<T>::value + WireOffset<Members<Ts...>, I - 1>::value>
+{
+};
+template <typename T, size_t N>
+struct WireSize<std::array<T, N>> : std::integral_constant<Size, N * WireSize<T>::value>
+{
+};
+template <typename T1, typename T2>
+struct WireSize<std::pair<T1, T2>> : WireSum<T1, T2>
+{
+};
+template <typename... Ts>
+struct WireSize<std::tuple<Ts...>> : WireSum<Ts...>
+{
+};
+template <typename T>
+struct WireSize<std::complex<T>> : std::integral_constant<Size, 2 * WireSize<T>::value>
+{
+};
+template <size_t N>
+struct WireSize<std::bitset<N>> : std::integral_constant<Size, (N + 7) / 8>
+{
+};
+template <typename R, typename P>
+struct WireSize<std::chrono::duration<R, P>> : WireSize<R>
+{
+};
+template <typename C, typename D>
+struct WireSize<std::chrono::time_point<C, D>> : WireSize<D>
+{
+};
+template <typename T>
+struct WireSize<std::atomic<T>> : WireSize<T>
+{
+};
+template <typename T>
+struct WireSize<NVP<T>> : WireSize<typename std::decay<T>::type>
+{
+};
+
+/// Catches `IsTriviallySerializable` types whose memory cannot be their binary encoding: types
+/// that are not trivially copyable, and registered types whose size differs from their wire size.
+template <typename T>
+struct IsBulkSafe
+    : std::integral_constant<bool, std::is_arithmetic<T>::value ||
+                                       (std::is_trivially_copyable<T>::value &&
+                                        (!IsRegistered<T>::value || WireSize<T>::value == sizeof(T)))>
+{
+};
+
+/// Number of bytes in each unit whose byte order is reversed when a `T` is written in a foreign byte
+/// order, or zero when `T` can't be byte-swapped as a block.
+template <typename T, class Enable = void>
+struct SwapUnit : std::integral_constant<Size, 0>
+{
+};
+template <typename T>
+struct SwapUnit<T, EnableIfT<std::is_arithmetic<T>::value || std::is_enum<T>::value>>
+    : std::integral_constant<Size, sizeof(T)>
+{
+};
+template <typename T>
+struct SwapUnit<std::complex<T>> : SwapUnit<T>
+{
+};
+
+/// Encoding policy of the default binary format. Every arithmetic value is written at its full
+/// width in the byte order `O`, so contiguous containers of bulk types are copied as they are.
+template <ByteOrder O = ByteOrder::Little>
+struct BasicFixedEncoding
+{
+    using Order = std::integral_constant<ByteOrder, O>;
+    using Variable = std::false_type;
+    using Scalar = OrderedType<O>;
+
+    template <typename T>
+    struct Compact : std::false_type
+    {
+    };
+    template <typename T>
+    struct Bulk : std::true_type
+    {
+    };
+};
+
+using FixedEncoding = BasicFixedEncoding<>;
+using BigFixedEncoding = BasicFixedEncoding<ByteOrder::Big>;
+
+/// Encoding policy selected by `SerializeOptions::varint`. Integers wider than one byte, including
+/// every container size, are written as LEB128 varints, ZigZag-mapped when signed. Only
+/// containers of floating-point and single-byte elements are still copied in bulk; floating-point
+/// values keep the byte order `O`.
+template <ByteOrder O = ByteOrder::Little>
+struct BasicVarintEncoding
+{
+    using Order = std::integral_constant<ByteOrder, O>;
+    using Variable = std::true_type;
+    using Scalar = OrderedType<O>;
+
+    template <typename T>
+    struct Compact : std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                                                      (sizeof(T) > 1) && (sizeof(T) <= 8)>
+    {
+    };
+    template <typename T>
+    struct Bulk : std::integral_constant<bool, std::is_arithmetic<T>::value && !Compact<T>::value>
+    {
+    };
+};
+
+using VarintEncoding = BasicVarintEncoding<>;
+using BigVarintEncoding = BasicVarintEncoding<ByteOrder::Big>;
+
+/// Marks the serializers and deserializers that run over memory whose size was checked up front.
+struct Unchecked
+{
+};
+
+/// Marks the deserializers that read input known to be well-formed, such as input that passed
+/// `Serio::validate()`, and so skip checking its lengths and bounds.
+struct Trusted
+{
+};
+
+/// Marks the serializers and deserializers of the flat format, which lays out registered classes of
+/// varying size as tables, so their members can be found without decoding the ones before them.
+struct FlatLayout
+{
+};
+
+template <typename E, typename It>
+void writeUnchecked(char* ptr, It it, Size count);
+
+template <typename E, typename It>
+void readUnchecked(const char* ptr, It it, Size count);
+
+template <typename Derived, typename T>
+void readIndexed(const char* data, Size size, Size maxLength, T* values, Size count);
+
+/// Output adapter that appends to a `std::string`. On C++23 standard libraries the string is grown
+/// with `resize_and_overwrite`, so new bytes are never zero-filled before being written.
+struct StringOutput
+{
+    using Target = std::string;
+    std::string& buffer;
+
+    StringOutput(std::string& buffer) : buffer(buffer) {}
+
+    char* take(Size size)
+    {
+        Size len = buffer.size();
+#ifdef __cpp_lib_string_resize_and_overwrite
+        if (len + size > buffer.capacity()) buffer.reserve(std::max<Size>(len + size, buffer.capacity() * 2));
+        buffer.resize_and_overwrite(len + size, [](char*, size_t n) { return n; });
+#else
+        buffer.append(size, 0);
+#endif
+        return &buffer[0] + len;
+    }
+    void write(const void* data, Size len) { buffer.append((const char*)data, len); }
+};
+
+/// Output adapter that appends to a `BasicBuffer`, which hands out uninitialized space directly.
+template <typename Allocator>
+struct BufferOutput
+{
+    using Target = BasicBuffer<Allocator>;
+    BasicBuffer<Allocator>& buffer;
+
+    BufferOutput(BasicBuffer<Allocator>& buffer) : buffer(buffer) {}
+
+    char* take(Size size) { return buffer.take(size); }
+    void write(const void* data, Size len) { buffer.append(data, len); }
+};
+
+/// Output adapter that appends to `Segments`, which references large blocks instead of copying them.
+struct SegmentOutput
+{
+    using Target = Segments;
+    Segments& segments;
+
+    SegmentOutput(Segments& segments) : segments(segments) {}
+
+    char* take(Size size) { return segments.take(size); }
+    void write(const void* data, Size len) { segments.append(data, len); }
+};
+
+#ifdef SERIO_UNIX
+/// Output adapter that writes straight into a growing file mapping.
+struct MappedOutput
+{
+    using Target = MappedFileWriter;
+    MappedFileWriter& file;
+
+    MappedOutput(MappedFileWriter& file) : file(file) {}
+
+    char* take(Size size) { return file.take(size); }
+    void write(const void* data, Size len) { std::memcpy(take(len), data, len); }
+};
+#endif
+
+/// Output adapter that writes through a raw pointer into memory that is known to be large enough.
+struct PointerOutput
+{
+    using Target = char*;
+    char*& ptr;
+
+    PointerOutput(char*& ptr) : ptr(ptr) {}
+
+    char* take(Size size)
+    {
+        char* data = ptr;
+        ptr += size;
+        return data;
+    }
+    void write(const void* data, Size len) { std::memcpy(take(len), data, len); }
+};
+
+template <typename Derived, typename Output, typename E = FixedEncoding>
 class SerializerBase
 {
     Derived& This() { return (Derived&)*this; }
 
-    char* take(Size size)
+    char* take(Size size) { return output.take(size); }
+
+    Output output;
+
+public:
+    using Encoding = E;
+
+    SerializerBase(typename Output::Target& buffer) : output(buffer) {}
+
+    template <typename T>
+    EnableIfT<(std::is_arithmetic<T>::value || std::is_enum<T>::value) && !E::template Compact<T>::value, Derived&>
+    operator<<(const T& value)
+    {
+        E::Scalar::serialize(take(sizeof(value)), value);
+        return This();
+    }
+    template <typename T>
+    EnableIfT<E::template Compact<T>::value, Derived&> operator<<(const T& value)
+    {
+        char data[Varint::MaxSize];
+        Size size = Varint::encode(data, Varint::zigzag(value));
+        std::memcpy(take(size), data, size);
+        return This();
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::basic_string<char, Ts...>& value)
+    {
+        This() << containerSize(value);
+        this->write(value.data(), value.size());
+        return This();
+    }
+    template <size_t N>
+    Derived& operator<<(const std::bitset<N>& value)
+    {
+        Bitset::serialize(take((N + 7) / 8), value);
+        return This();
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::vector<bool, Ts...>& value)
+    {
+        This() << Size(value.size());
+        Bitset::serialize(take((value.size() + 7) / 8), value);
+        return This();
+    }
+    void write(const void* data, Size len) { output.write(data, len); }
+    template <Size N>
+    void writeSwapped(const char* data, Size count)
+    {
+        ByteSwap<N>::copy(take(count * N), data, count);
+    }
+    template <typename It>
+    void writeFixed(It it, Size count)
+    {
+        using T = typename std::iterator_traits<It>::value_type;
+        writeUnchecked<E>(take(count * WireSize<T>::value), it, count);
+    }
+
+#if SERIO_CPP_VERSION >= 201703L
+    template <typename... Ts>
+    Derived& operator<<(const std::basic_string_view<char, Ts...>& value)
+    {
+        This() << containerSize(value);
+        this->write(value.data(), value.size());
+        return This();
+    }
+#endif
+};
+
+/// Sink that hands bytes to the buffer of a `std::ostream`.
+struct StreamSink
+{
+    using Target = std::ostream&;
+    std::streambuf* buffer;
+
+    StreamSink(std::ostream& stream) : buffer(stream.rdbuf()) {}
+
+    Size alignment() const { return 1; }
+    Size write(const char* data, Size size, bool) { return buffer->sputn(data, size), size; }
+};
+
+#ifdef SERIO_UNIX
+/// Sink that writes to a POSIX file descriptor, such as a file, pipe or socket, without going
+/// through `FILE*` or iostreams. On descriptors opened with `O_DIRECT` only whole aligned blocks are
+/// written, from the aligned buffer of the serializer. `O_DIRECT` is turned off while the final tail
+/// is written, and until the sink is destroyed if the descriptor rejects an aligned transfer; the
+/// flags of the descriptor are restored afterwards.
+struct FdSink
+{
+    using Target = int;
+    int fd;
+    bool direct;
+    int error = 0;
+    int flags = -1;
+
+    FdSink(int fd) : fd(fd), direct(isDirect(fd)) {}
+    FdSink(const FdSink&) = delete;
+    FdSink& operator=(const FdSink&) = delete;
+    ~FdSink() { restoreFlags(fd, flags); }
+
+    // Writes as much of `[data, data + size)` as the descriptor accepts. `error` is left with the
+    // errno of the write that stopped it, or 0 when the descriptor took no more.
+    Size send(const char* data, Size size)
+    {
+        Size done = 0;
+        error = 0;
+        while (done < size)
+        {
+            auto count = ::write(fd, data + done, size - done);
+            if (count < 0 && errno == EINTR) continue;
+            if (count < 0) error = errno;
+            if (count <= 0) break;
+            done += Size(count);
+        }
+        return done;
+    }
+
+    Size alignment() const { return direct ? Size(AlignedBuffer::Alignment) : 1; }
+
+    /// Writes `[data, data + size)`, except for a tail shorter than `alignment()` when `all` is false.
+    /// Returns the number of bytes written.
+    Size write(const char* data, Size size, bool all)
+    {
+        Size done = 0;
+        if (direct)
+        {
+            Size block = size - size % AlignedBuffer::Alignment;
+            done = send(data, block);
+            if (done == size || (done == block && !all)) return done;
+            SERIO_ASSERT(done == block || error == EINVAL, "Failed to write to file descriptor");
+            bool rejected = done < block;
+            int previous = clearDirect(fd);
+            done += send(data + done, size - done);
+            if (rejected)
+            {
+                direct = false;
+                flags = previous;
+            }
+            else
+                restoreFlags(fd, previous);
+        }
+        else
+            done = send(data, size);
+        SERIO_ASSERT(done == size, "Failed to write to file descriptor");
+        return done;
+    }
+};
+#endif
+
+/// Serializes to a `Sink` through a write-combining buffer, so small values cost a copy instead of
+/// a call to the sink each. The buffer is flushed when it fills up and on destruction; writes of at
+/// least its size bypass it unless the sink needs aligned blocks.
+template <typename Derived, typename Sink, typename E = FixedEncoding>
+struct StreamSerializerBase
+{
+    AlignedBuffer _buffer;
+    Size _used{0};
+    Sink _sink;
+    Derived& This() { return (Derived&)*this; }
+
+    // Hands the buffered bytes to the sink, except for a tail it may keep back for alignment.
+    void drain()
+    {
+        Size done = _sink.write(_buffer.data(), _used, false);
+        if (done < _used) std::memmove(_buffer.data(), _buffer.data() + done, _used - done);
+        _used -= done;
+    }
+
+    char* take(Size size)
+    {
+        if (size > _buffer.size() - _used) drain();
+        if (size > _buffer.size() - _used) _buffer.resize(_used + size);
+        char* data = _buffer.data() + _used;
+        _used += size;
+        return data;
+    }
+
+public:
+    using Encoding = E;
+
+    StreamSerializerBase(typename Sink::Target target, Size capacity = Size(1) << 16) : _sink(target)
+    {
+        Size align = _sink.alignment();
+        _buffer.resize((std::max<Size>(capacity, 16) + align - 1) / align * align);
+    }
+    StreamSerializerBase(const StreamSerializerBase&) = delete;
+    ~StreamSerializerBase()
+    {
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    /// Hands all buffered bytes to the sink.
+    void flush()
+    {
+        Size used = _used;
+        _used = 0;
+        if (used > 0) _sink.write(_buffer.data(), used, true);
+    }
+
+    template <typename T>
+    EnableIfT<(std::is_arithmetic<T>::value || std::is_enum<T>::value) && !E::template Compact<T>::value, Derived&>
+    operator<<(const T& value)
+    {
+        E::Scalar::serialize(take(sizeof(value)), value);
+        return This();
+    }
+    template <typename T>
+    EnableIfT<E::template Compact<T>::value, Derived&> operator<<(const T& value)
+    {
+        char data[Varint::MaxSize];
+        Size size = Varint::encode(data, Varint::zigzag(value));
+        std::memcpy(take(size), data, size);
+        return This();
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::basic_string<char, Ts...>& value)
+    {
+        This() << containerSize(value);
+        write(value.data(), value.size());
+        return This();
+    }
+    template <size_t N>
+    Derived& operator<<(const std::bitset<N>& value)
+    {
+        Bitset::serialize(take((N + 7) / 8), value);
+        return This();
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::vector<bool, Ts...>& value)
+    {
+        This() << Size(value.size());
+        Bitset::serialize(take((value.size() + 7) / 8), value);
+        return This();
+    }
+    void write(const void* data, Size len)
+    {
+        if (len > _buffer.size() - _used) drain();
+        if (len >= _buffer.size() && _sink.alignment() == 1)
+        {
+            _sink.write((const char*)data, len, true);
+            return;
+        }
+        for (auto* bytes = (const char*)data; len > 0;)
+        {
+            Size size = std::min(len, _buffer.size() - _used);
+            if (size == 0)
+            {
+                drain();
+                continue;
+            }
+            std::memcpy(take(size), bytes, size);
+            bytes += size, len -= size;
+        }
+    }
+    template <Size N>
+    void writeSwapped(const char* data, Size count)
+    {
+        Size chunk = std::max<Size>(1, _buffer.size() / N);
+        while (count > 0)
+        {
+            Size items = std::min(count, chunk);
+            ByteSwap<N>::copy(take(items * N), data, items);
+            data += items * N;
+            count -= items;
+        }
+    }
+    template <typename It>
+    void writeFixed(It it, Size count)
+    {
+        using T = typename std::iterator_traits<It>::value_type;
+        Size chunk = std::max<Size>(1, _buffer.size() / WireSize<T>::value);
+        while (count > 0)
+        {
+            Size items = std::min(count, chunk);
+            writeUnchecked<E>(take(items * WireSize<T>::value), it, items);
+            std::advance(it, items);
+            count -= items;
+        }
+    }
+
+#if SERIO_CPP_VERSION >= 201703L
+    template <typename... Ts>
+    Derived& operator<<(const std::basic_string_view<char, Ts...>& value)
+    {
+        This() << containerSize(value);
+        this->write(value.data(), value.size());
+        return This();
+    }
+#endif
+};
+
+template <typename Derived, typename E = FixedEncoding>
+class SizeSerializerBase
+{
+    Size _size{0};
+    Derived& This() { return (Derived&)*this; }
+
+public:
+    using Encoding = E;
+
+    Size size() const { return _size; }
+
+    template <typename T>
+    EnableIfT<(std::is_arithmetic<T>::value || std::is_enum<T>::value) && !E::template Compact<T>::value, Derived&>
+    operator<<(const T& value)
+    {
+        _size += sizeof(value);
+        return This();
+    }
+    template <typename T>
+    EnableIfT<E::template Compact<T>::value, Derived&> operator<<(const T& value)
+    {
+        _size += Varint::size(Varint::zigzag(value));
+        return This();
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::basic_string<char, Ts...>& value)
+    {
+        This() << containerSize(value);
+        _size += value.size();
+        return This();
+    }
+    template <size_t N>
+    Derived& operator<<(const std::bitset<N>&)
+    {
+        _size += (N + 7) / 8;
+        return This();
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::vector<bool, Ts...>& value)
+    {
+        This() << Size(value.size());
+        _size += (value.size() + 7) / 8;
+        return This();
+    }
+    void write(const void*, Size len) { _size += len; }
+    template <Size N>
+    void writeSwapped(const char*, Size count)
+    {
+        _size += count * N;
+    }
+    template <typename It>
+    void writeFixed(It, Size count)
+    {
+        _size += count * WireSize<typename std::iterator_traits<It>::value_type>::value;
+    }
+
+#if SERIO_CPP_VERSION >= 201703L
+    template <typename... Ts>
+    Derived& operator<<(const std::basic_string_view<char, Ts...>& value)
+    {
+        This() << containerSize(value);
+        _size += value.size();
+        return This();
+    }
+#endif
+};
+
+template <typename Derived, typename E = FixedEncoding>
+class DeserializerBase
+{
+    const char* start{nullptr};
+    const char* buffer{nullptr};
+    Size length{0};
+    Size maxLength{0};
+    bool zeroCopy{false};
+    bool reuse{false};
+    MemoryResource* resource{nullptr};
+
+    template <typename T>
+    T get()
+    {
+        T value;
+        This() >> value;
+        return value;
+    }
+
+    void advance(Size size)
+    {
+        this->buffer += size;
+        this->length -= size;
+        This().advanced(this->buffer);
+    }
+
+    Derived& This() { return (Derived&)*this; }
+
+    // Asserts that `size` more bytes are left, unless the input is trusted to hold them.
+    void require(Size size)
+    {
+        if (!std::is_base_of<Trusted, Derived>::value)
+            SERIO_ASSERT(length >= size, "Requested structure doesn't match the input buffer");
+    }
+
+public:
+    using Encoding = E;
+
+    DeserializerBase(const char* ptr, Size length, Size maxLength, bool zeroCopy = false, bool reuse = false,
+                     MemoryResource* resource = nullptr)
+        : start(ptr),
+          buffer(ptr),
+          length(length),
+          maxLength(maxLength),
+          zeroCopy(zeroCopy),
+          reuse(reuse),
+          resource(resource)
+    {
+    }
+
+    /// Called whenever the read position moves forward to `ptr`. Does nothing; derived classes may
+    /// hide it to follow the progress.
+    void advanced(const char*) {}
+
+    Size progress() { return buffer - start; }
+
+    /// The largest container length accepted, or zero for no limit.
+    Size lengthLimit() const { return maxLength; }
+
+    /// Whether containers, pointers and optionals keep what they already hold for the new values.
+    bool reusing() const { return reuse; }
+
+    /// Where the objects created while decoding take their memory from, or null for the heap.
+    MemoryResource* memoryResource() const { return resource; }
+
+    Size getLength()
+    {
+        auto size = this->get<Size>();
+        if (!std::is_base_of<Trusted, Derived>::value && maxLength > 0)
+            SERIO_ASSERT(size <= maxLength, "Requested container size above maximum limit");
+        return size;
+    }
+
+    template <typename T>
+    EnableIfT<(std::is_arithmetic<T>::value || std::is_enum<T>::value) && !E::template Compact<T>::value, Derived&>
+    operator>>(T& value)
+    {
+        require(sizeof(value));
+        E::Scalar::deserialize(this->buffer, value);
+        advance(sizeof(value));
+        return This();
+    }
+    template <typename T>
+    EnableIfT<E::template Compact<T>::value, Derived&> operator>>(T& value)
+    {
+        uint64_t raw;
+        Size size = Varint::decode(this->buffer, length, raw);
+        SERIO_ASSERT(size > 0 && Varint::unzigzag(raw, value), "Requested structure doesn't match the input buffer");
+        advance(size);
+        return This();
+    }
+    template <typename... Ts>
+    Derived& operator>>(std::basic_string<char, Ts...>& value)
+    {
+        value.resize(getLength());
+        require(value.size());
+        std::copy(this->buffer, this->buffer + value.size(), &value[0]);
+        advance(value.size());
+        return This();
+    }
+    template <size_t N>
+    Derived& operator>>(std::bitset<N>& value)
+    {
+        size_t size = (N + 7) / 8;
+        require(size);
+        Bitset::deserialize(this->buffer, value);
+        advance(size);
+        return This();
+    }
+    template <typename... Ts>
+    Derived& operator>>(std::vector<bool, Ts...>& value)
+    {
+        value.resize(getLength());
+        size_t size = (value.size() + 7) / 8;
+        require(size);
+        Bitset::deserialize(this->buffer, value);
+        advance(size);
+        return This();
+    }
+    template <typename T>
+    void read(T* data, Size len)
+    {
+        len *= sizeof(T);
+        require(len);
+        std::memcpy((void*)data, this->buffer, len);
+        advance(len);
+    }
+    template <typename It>
+    void readFixed(It it, Size count)
+    {
+        using T = typename std::iterator_traits<It>::value_type;
+        if (!std::is_base_of<Trusted, Derived>::value)
+            SERIO_ASSERT(count <= length / WireSize<T>::value, "Requested structure doesn't match the input buffer");
+        readUnchecked<E>(this->buffer, it, count);
+        advance(count * WireSize<T>::value);
+    }
+    /// Returns the next `len` bytes of the input in place, for a view to bind to, and moves past
+    /// them. Only allowed in zero-copy mode, and only when they start at a multiple of `align`.
+    const char* borrow(Size len, Size align)
+    {
+        SERIO_ASSERT(zeroCopy, "Views can only be deserialized in zero-copy mode");
+        require(len);
+        SERIO_ASSERT(len == 0 || reinterpret_cast<std::uintptr_t>(this->buffer) % align == 0,
+                     "View elements are not aligned in the input buffer");
+        const char* data = this->buffer;
+        advance(len);
+        return data;
+    }
+    /// Moves past the next `len` bytes of the input without reading them.
+    void skip(Size len)
+    {
+        require(len);
+        advance(len);
+    }
+};
+
+template <typename Derived, typename E = FixedEncoding>
+class UncheckedDeserializerBase : public Unchecked
+{
+    const char* buffer;
+
+    Derived& This() { return (Derived&)*this; }
+
+public:
+    using Encoding = E;
+
+    UncheckedDeserializerBase(const char* ptr) : buffer(ptr) {}
+
+    bool reusing() const { return false; }
+
+    MemoryResource* memoryResource() const { return nullptr; }
+
+    template <typename T>
+    EnableIfT<std::is_arithmetic<T>::value || std::is_enum<T>::value, Derived&> operator>>(T& value)
+    {
+        E::Scalar::deserialize(this->buffer, value);
+        this->buffer += sizeof(value);
+        return This();
+    }
+    template <size_t N>
+    Derived& operator>>(std::bitset<N>& value)
+    {
+        Bitset::deserialize(this->buffer, value);
+        this->buffer += (N + 7) / 8;
+        return This();
+    }
+    template <typename T>
+    void read(T* data, Size len)
+    {
+        std::memcpy((void*)data, this->buffer, len * sizeof(T));
+        this->buffer += len * sizeof(T);
+    }
+    void skip(Size len) { this->buffer += len; }
+};
+
+/// Reads the get area of any stream buffer, which holds bytes it can always take back.
+struct GetArea : std::streambuf
+{
+    static Size size(std::streambuf* buffer)
+    {
+        auto begin = &GetArea::gptr, end = &GetArea::egptr;
+        return Size((buffer->*end)() - (buffer->*begin)());
+    }
+};
+
+/// Source that reads from the buffer of a `std::istream`. Only what the stream can deliver without
+/// blocking is read ahead; on streams that can't seek, only what the stream buffer already holds,
+/// so that bytes read ahead but not consumed can always be put back.
+struct StreamSource
+{
+    using Target = std::istream&;
+    std::streambuf* buffer;
+    bool seekable;
+
+    StreamSource(std::istream& stream) : buffer(stream.rdbuf())
+    {
+        auto position = buffer->pubseekoff(0, std::ios::cur, std::ios::in);
+        seekable = position != std::streampos(std::streamoff(-1));
+    }
+
+    /// Reads at least `need` and at most `space` bytes into `data`, fewer only at the end of the
+    /// input. Returns the number of bytes read.
+    Size read(char* data, Size need, Size space)
+    {
+        auto ready = seekable ? buffer->in_avail() : std::streamsize(GetArea::size(buffer));
+        Size ahead = ready > 0 ? std::min(space, Size(ready)) : 0;
+        auto count = buffer->sgetn(data, std::max(need, ahead));
+        return count > 0 ? Size(count) : 0;
+    }
+
+    /// Gives back the last `size` bytes read, which end at `end`, by seeking back or else by
+    /// putting them back. Returns the number of bytes the stream took.
+    Size unread(const char* end, Size size)
+    {
+        if (size == 0) return 0;
+        auto offset = -std::streamoff(size);
+        if (seekable && buffer->pubseekoff(offset, std::ios::cur, std::ios::in) != std::streampos(std::streamoff(-1)))
+            return size;
+        Size count = 0;
+        while (count < size && buffer->sputbackc(end[-1 - std::ptrdiff_t(count)]) != std::char_traits<char>::eof())
+            ++count;
+        return count;
+    }
+};
+
+#ifdef SERIO_UNIX
+/// Source that reads from a POSIX file descriptor. Every read asks for as much as the window can
+/// take; bytes read past the last value are given back by seeking, which pipes and sockets can't do,
+/// so there they stay in `remaining()` of the deserializer. If a descriptor opened with `O_DIRECT`
+/// rejects an unaligned read, `O_DIRECT` is turned off.
+struct FdSource
+{
+    using Target = int;
+    int fd;
+
+    FdSource(int fd) : fd(fd) {}
+
+    Size read(char* data, Size need, Size space)
+    {
+        Size done = 0;
+        while (done < need)
+        {
+            auto count = ::read(fd, data + done, space - done);
+            if (count < 0 && errno == EINVAL && isDirect(fd))
+                clearDirect(fd);
+            else if (count < 0)
+                SERIO_ASSERT(errno == EINTR, "Failed to read from file descriptor");
+            else if (count == 0)
+                break;
+            else
+                done += Size(count);
+        }
+        return done;
+    }
+
+    Size unread(const char*, Size size)
+    {
+        if (size == 0 || lseek(fd, -off_t(size), SEEK_CUR) != -1) return size;
+        return 0;
+    }
+};
+#endif
+
+/// Deserializes from a `Source` through a read-ahead window, so small values are decoded in place
+/// instead of costing a call to the source each. Reads of at least the window size go straight to
+/// their destination. Bytes read ahead but not consumed are given back to the source on
+/// destruction.
+template <typename Derived, typename Source, typename E = FixedEncoding>
+struct StreamDeserializerBase
+{
+    AlignedBuffer _buffer;
+    Size _begin{0}, _end{0};
+    Source _source;
+    Size _maxLength{0};
+    bool _reuse{false};
+    MemoryResource* _resource{nullptr};
+
+    template <typename T>
+    T get()
+    {
+        T value;
+        This() >> value;
+        return value;
+    }
+
+    Derived& This() { return (Derived&)*this; }
+
+    // Makes at least `size` bytes available in the window and returns a pointer to them.
+    const char* fetch(Size size)
+    {
+        if (size <= _end - _begin) return _buffer.data() + _begin;
+        if (_begin > 0) std::memmove(_buffer.data(), _buffer.data() + _begin, _end - _begin);
+        _end -= _begin, _begin = 0;
+        if (size > _buffer.size()) _buffer.resize(size);
+
+        _end += _source.read(_buffer.data() + _end, size - _end, _buffer.size() - _end);
+        SERIO_ASSERT(_end >= size, "Requested structure doesn't match the input stream");
+        return _buffer.data();
+    }
+
+public:
+    using Encoding = E;
+
+    StreamDeserializerBase(typename Source::Target target, Size maxLength, Size capacity = Size(1) << 18,
+                           bool reuse = false, MemoryResource* resource = nullptr)
+        : _source(target), _maxLength(maxLength), _reuse(reuse), _resource(resource)
+    {
+        _buffer.resize(std::max<Size>(capacity, 16));
+    }
+    StreamDeserializerBase(const StreamDeserializerBase&) = delete;
+    ~StreamDeserializerBase() { release(); }
+
+    /// The bytes that were read ahead from the source but not consumed yet.
+    StringView remaining() const { return StringView(_buffer.data() + _begin, _end - _begin); }
+
+    /// Gives the bytes in `remaining()` back to the source. Returns false when it doesn't take all
+    /// of them; the rest stay in `remaining()`.
+    bool release()
+    {
+        _end -= _source.unread(_buffer.data() + _end, _end - _begin);
+        return _begin == _end;
+    }
+
+    /// The largest container length accepted, or zero for no limit.
+    Size lengthLimit() const { return _maxLength; }
+
+    /// Whether containers, pointers and optionals keep what they already hold for the new values.
+    bool reusing() const { return _reuse; }
+
+    /// Where the objects created while decoding take their memory from, or null for the heap.
+    MemoryResource* memoryResource() const { return _resource; }
+
+    Size getLength()
+    {
+        auto size = this->get<Size>();
+        if (_maxLength > 0) SERIO_ASSERT(size <= _maxLength, "Requested container size above maximum limit");
+        return size;
+    }
+
+    template <typename T>
+    EnableIfT<(std::is_arithmetic<T>::value || std::is_enum<T>::value) && !E::template Compact<T>::value, Derived&>
+    operator>>(T& value)
+    {
+        E::Scalar::deserialize(fetch(sizeof(value)), value);
+        _begin += sizeof(value);
+        return This();
+    }
+    template <typename T>
+    EnableIfT<E::template Compact<T>::value, Derived&> operator>>(T& value)
+    {
+        uint64_t raw = 0;
+        if (_end - _begin >= Varint::MaxSize)
+        {
+            Size size = Varint::decode(_buffer.data() + _begin, _end - _begin, raw);
+            SERIO_ASSERT(size > 0, "Requested structure doesn't match the input stream");
+            _begin += size;
+        }
+        else
+            for (Size i = 0;; ++i)
+            {
+                uint8_t byte = uint8_t(*fetch(1));
+                ++_begin;
+                SERIO_ASSERT(i < Varint::MaxSize - 1 || byte <= 1,
+                             "Requested structure doesn't match the input stream");
+                raw |= uint64_t(byte & 0x7F) << (7 * i);
+                if (!(byte & 0x80)) break;
+            }
+        SERIO_ASSERT(Varint::unzigzag(raw, value), "Requested structure doesn't match the input stream");
+        return This();
+    }
+    template <typename... Ts>
+    Derived& operator>>(std::basic_string<char, Ts...>& value)
+    {
+        auto size = getLength();
+        value.resize(size);
+        if (size > 0) read(&value.front(), value.size());
+        return This();
+    }
+    template <size_t N>
+    Derived& operator>>(std::bitset<N>& value)
+    {
+        auto size = size_t((N + 7) / 8);
+        if (size == 0) return This();
+        Bitset::deserialize(fetch(size), value);
+        _begin += size;
+        return This();
+    }
+    template <typename... Ts>
+    Derived& operator>>(std::vector<bool, Ts...>& value)
+    {
+        value.resize(getLength());
+        if (value.size() == 0) return This();
+        auto size = size_t((value.size() + 7) / 8);
+        Bitset::deserialize(fetch(size), value);
+        _begin += size;
+        return This();
+    }
+    template <typename T>
+    void read(T* data, Size len)
+    {
+        len *= sizeof(T);
+        Size ready = std::min(len, _end - _begin);
+        std::memcpy((void*)data, _buffer.data() + _begin, ready);
+        _begin += ready, len -= ready;
+        if (len == 0) return;
+
+        char* rest = (char*)data + ready;
+        if (len >= _buffer.size())
+        {
+            auto size = _source.read(rest, len, len);
+            SERIO_ASSERT(size == len, "Requested structure doesn't match the input stream");
+            return;
+        }
+        std::memcpy(rest, fetch(len), len);
+        _begin += len;
+    }
+    const char* borrow(Size, Size)
+    {
+        SERIO_ASSERT(false, "Views can't be deserialized from a stream");
+        return nullptr;
+    }
+    /// Moves past the next `len` bytes of the input, reading them into the window and dropping them.
+    void skip(Size len)
+    {
+        Size ready = std::min(len, _end - _begin);
+        _begin += ready, len -= ready;
+        while (len > 0)
+        {
+            Size size = std::min(len, _buffer.size());
+            fetch(size);
+            _begin += size, len -= size;
+        }
+    }
+    template <typename It>
+    void readFixed(It it, Size count)
+    {
+        using T = typename std::iterator_traits<It>::value_type;
+        Size chunk = std::max<Size>(1, _buffer.size() / WireSize<T>::value);
+        while (count > 0)
+        {
+            Size items = std::min(count, chunk), size = items * WireSize<T>::value;
+            readUnchecked<E>(fetch(size), it, items);
+            _begin += size;
+            std::advance(it, items);
+            count -= items;
+        }
+    }
+};
+
+/// True when `Derived` should hand values of type `T` to its `writeFixed` or `readFixed`, which
+/// size the output or check the input length once for the whole value.
+template <typename T, typename Derived>
+struct HoistFixed
+    : std::integral_constant<bool, (WireSize<T>::value > 0) && !std::is_base_of<Unchecked, Derived>::value &&
+                                       !Derived::Encoding::Variable::value>
+{
+};
+
+/// True when `Derived` writes `T` as a table: a registered class of varying size in the flat format.
+template <typename T, typename Derived>
+struct IsTable : std::integral_constant<bool, std::is_base_of<FlatLayout, Derived>::value && IsRegistered<T>::value &&
+                                                  WireSize<T>::value == 0>
+{
+};
+
+enum class BulkMode
+{
+    None,
+    Copy,
+    Swap,
+};
+
+template <BulkMode M>
+using BulkTag = std::integral_constant<BulkMode, M>;
+
+/// How contiguous containers of `T` are handled under the encoding of `Derived`: copied as they are
+/// when the wire byte order is the native one, byte-swapped in blocks when it is the other one, and
+/// encoded element by element otherwise.
+template <typename T, typename Derived, typename E = typename Derived::Encoding>
+struct BulkFor
+    : BulkTag<!E::template Bulk<T>::value ? BulkMode::None
+              : SwapUnit<T>::value == 1 || E::Order::value == nativeOrder()
+                  ? BulkMode::Copy
+                  : (SwapUnit<T>::value > 1 && nativeOrder() != ByteOrder::Unknown ? BulkMode::Swap : BulkMode::None)>
+{
+};
+
+template <typename E>
+struct BasicSizeSerializer;
+struct FlatSizeSerializer;
+
+/// The serializer that measures what `Derived` would write.
+template <typename Derived>
+using SizerFor = typename std::conditional<std::is_base_of<FlatLayout, Derived>::value, FlatSizeSerializer,
+                                           BasicSizeSerializer<typename Derived::Encoding>>::type;
+
+/// An address that stands for the type `T`, so tracked objects are only shared by pointers to one type.
+template <typename T>
+const void* typeTag()
+{
+    static const char tag = 0;
+    return &tag;
+}
+
+template <typename Derived>
+class SerializerOps : public Base::Serializer, public Base::Binary
+{
+    Derived& This() { return (Derived&)*this; }
+
+    // The shared objects written so far, with the ids both sides give them in order of appearance.
+    struct Tracked
+    {
+        std::unordered_map<const void*, std::pair<Size, const void*>> ids;
+        Size count = 0;
+    };
+    std::unique_ptr<Tracked> tracked;
+
+    template <typename T>
+    using Hoist = HoistFixed<T, Derived>;
+
+    template <typename T>
+    Derived& hoist(const T& value, std::true_type)
+    {
+        This().writeFixed(&value, 1);
+        return This();
+    }
+    template <typename T>
+    Derived& hoist(const T& value, std::false_type)
+    {
+        return plain(value);
+    }
+    template <typename T>
+    Derived& plain(const T& value)
+    {
+        return table(value, IsTable<T, Derived>());
+    }
+    template <typename T>
+    Derived& table(const T& value, std::true_type)
+    {
+        This().writeTable(value);
+        return This();
+    }
+    template <typename T>
+    Derived& table(const T& value, std::false_type)
+    {
+        CustomClass<T>().serialize(value, This());
+        return This();
+    }
+    template <typename T1, typename T2>
+    Derived& plain(const std::pair<T1, T2>& value)
+    {
+        return This() << value.first << value.second;
+    }
+    template <typename... Ts>
+    Derived& plain(const std::tuple<Ts...>& value)
+    {
+        Tuple<sizeof...(Ts)>::serialize(This(), value);
+        return This();
+    }
+    template <typename It>
+    void items(It it, Size count, std::true_type)
+    {
+        This().writeFixed(it, count);
+    }
+    template <typename It>
+    void items(It it, Size count, std::false_type)
+    {
+        for (; count > 0; --count, ++it) This() << *it;
+    }
+    template <typename T>
+    void bulk(const T* data, Size count, BulkTag<BulkMode::Copy>)
+    {
+        This().write(data, count * sizeof(T));
+    }
+    template <typename T>
+    void bulk(const T* data, Size count, BulkTag<BulkMode::Swap>)
+    {
+        using Unit = SwapUnit<T>;
+        This().template writeSwapped<Unit::value>((const char*)data, count * (sizeof(T) / Unit::value));
+    }
+    template <typename T>
+    void bulk(const T* data, Size count, BulkTag<BulkMode::None>)
+    {
+        items(data, count, std::false_type());
+    }
+    // Writes 0 for null, 1 ahead of an object seen for the first time and 2 plus its id for one
+    // written before. The id is taken before the object is written, so cycles end at a reference.
+    template <typename T>
+    bool share(const std::shared_ptr<T>& value)
+    {
+        if (!value)
+        {
+            This() << Size(0);
+            return true;
+        }
+
+        auto tag = typeTag<typename std::remove_const<T>::type>();
+        auto it = tracked->ids.find(value.get());
+        if (it != tracked->ids.end() && it->second.second == tag)
+        {
+            This() << it->second.first + 2;
+            return true;
+        }
+        if (it == tracked->ids.end()) tracked->ids.emplace(value.get(), std::make_pair(tracked->count, tag));
+        ++tracked->count;
+        This() << Size(1);
+        pointee(*value);
+        return true;
+    }
+    template <typename T>
+    bool share(const T&)
+    {
+        return false;
+    }
+    // Objects behind pointers to a class with derived classes listed are written after the id of
+    // their own class, through a table indexed by it.
+    template <typename T>
+    void pointee(const T& value)
+    {
+        pointee(value, HasDerived<typename std::remove_const<T>::type>());
+    }
+    template <typename T>
+    void pointee(const T& value, std::false_type)
+    {
+        This() << value;
+    }
+    template <typename T>
+    void pointee(const T& value, std::true_type)
+    {
+        using Types = typename PolymorphicTypes<typename std::remove_const<T>::type>::Types;
+        auto id = derivedId(value, Types());
+        This() << id;
+        derived<T>(id, dynamic_cast<const void*>(&value), Types());
+    }
+    template <typename T, typename... Ts>
+    void derived(Size id, const void* value, DerivedTypes<Ts...>)
+    {
+        using Write = void (SerializerOps::*)(const void*);
+        static const Write writes[] = {&SerializerOps::object<T, Ts>...};
+        (this->*writes[id])(value);
+    }
+    // `value` points to the most derived object, which is a `U`.
+    template <typename T, typename U>
+    void object(const void* value)
+    {
+        static_assert(std::is_base_of<T, U>::value, "Listed classes must derive from the pointer type.");
+        This() << *static_cast<const U*>(value);
+    }
+#if SERIO_ENABLE_FILESYSTEM
+    // A path whose native string is narrow is written straight from its own storage. Others are
+    // converted first, and the bytes of that temporary are copied so no output keeps a reference.
+    void path(const std::filesystem::path& value, std::true_type)
+    {
+        This() << value.native();
+    }
+    void path(const std::filesystem::path& value, std::false_type)
+    {
+        auto text = value.string();
+        This() << containerSize(text);
+        items(text.data(), text.size(), std::false_type());
+    }
+#endif
+
+public:
+    /// Turns pointer tracking on or off. When on, an object owned by `std::shared_ptr` is written
+    /// the first time it is met and later pointers to it refer back to it, so shared objects are
+    /// written once and cycles of pointers can be written at all.
+    Derived& tracking(bool on)
+    {
+        tracked.reset(on ? new Tracked() : nullptr);
+        return This();
+    }
+
+    template <typename T>
+    EnableIfT<std::is_class<T>::value && !IsFixed<T>::value && !IsResizable<T>::value && !IsAppendable<T>::value &&
+                  !IsPointer<T>::value && !IsOptional<T>::value,
+              Derived&>
+    operator<<(const T& value)
+    {
+        return hoist(value, Hoist<T>());
+    }
+    template <typename T>
+    EnableIfT<IsContinuous<T>::value, Derived&> operator<<(const T& value)
+    {
+        static_assert(IsBulkSafe<typename T::value_type>::value, "Type is not trivially serializable.");
+        if (!IsFixed<T>::value) This() << containerSize(value);
+        bulk(value.data(), value.size(), BulkFor<typename T::value_type, Derived>());
+        return This();
+    }
+    template <typename T>
+    EnableIfT<(IsFixed<T>::value || IsResizable<T>::value || IsAppendable<T>::value) && !IsContinuous<T>::value,
+              Derived&>
+    operator<<(const T& value)
+    {
+        using Type = typename std::iterator_traits<decltype(std::begin(value))>::value_type;
+        auto size = containerSize(value);
+        if (!IsFixed<T>::value) This() << size;
+        items(std::begin(value), size, Hoist<Type>());
+        return This();
+    }
+    template <typename T>
+    EnableIfT<IsPointer<T>::value, Derived&> operator<<(const T& value)
+    {
+        if (tracked && share(value)) return This();
+        This() << bool(value);
+        if (value) pointee(*value.get());
+        return This();
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::chrono::duration<Ts...>& value)
+    {
+        return This() << value.count();
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::chrono::time_point<Ts...>& value)
+    {
+        return This() << value.time_since_epoch();
+    }
+    template <typename T>
+    Derived& operator<<(const std::weak_ptr<T>& value)
+    {
+        return This() << value.lock();
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::queue<Ts...>& value)
+    {
+        return This() << static_cast<const Queue<Ts...>&>(value).c;
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::stack<Ts...>& value)
+    {
+        return This() << static_cast<const Stack<Ts...>&>(value).c;
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::priority_queue<Ts...>& value)
+    {
+        return This() << static_cast<const PQueue<Ts...>&>(value).c;
+    }
+    template <typename T1, typename T2>
+    Derived& operator<<(const std::pair<T1, T2>& value)
+    {
+        return hoist(value, Hoist<std::pair<T1, T2>>());
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::tuple<Ts...>& value)
+    {
+        return hoist(value, Hoist<std::tuple<Ts...>>());
+    }
+    template <typename T>
+    Derived& operator<<(const std::complex<T>& value)
+    {
+        return This() << value.real() << value.imag();
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::atomic<Ts...>& value)
+    {
+        return This() << value.load();
+    }
+    template <typename T>
+    Derived& operator<<(const BinaryString<T>& value)
+    {
+        return This() << value.value;
+    }
+    template <typename T>
+    Derived& operator<<(const NVP<T>& value)
+    {
+        return This() << value.value;
+    }
+    template <typename T>
+    Derived& operator<<(const Indexed<T>& value)
+    {
+        SERIO_ASSERT(!tracked, "Indexed vectors can't be written with pointer tracking");
+        using Type = typename std::decay<decltype(*std::begin(value.value))>::type;
+        auto size = containerSize(value.value);
+        This() << size;
+
+        char entry[sizeof(Size)];
+        Size offset = 0;
+        for (const auto& item : value.value)
+        {
+            BasicType::serialize(entry, offset);
+            This().write(entry, sizeof(Size));
+            offset += Hoist<Type>::value ? WireSize<Type>::value : SizerFor<Derived>().process(item).size();
+        }
+        BasicType::serialize(entry, offset);
+        This().write(entry, sizeof(Size));
+
+        items(std::begin(value.value), size, Hoist<Type>());
+        return This();
+    }
+
+#if SERIO_CPP_VERSION >= 201703L
+    template <typename T>
+    EnableIfT<IsOptional<T>::value, Derived&> operator<<(const T& value)
+    {
+        This() << value.has_value();
+        if (value.has_value()) This() << value.value();
+        return This();
+    }
+    template <typename... Ts>
+    Derived& operator<<(const std::variant<Ts...>& value)
+    {
+        This() << Size(value.index());
+        std::visit([&](auto&& arg) { This() << arg; }, value);
+        return This();
+    }
+    Derived& operator<<(const std::monostate&)  //
+    {
+        return This();
+    }
+#endif
+
+#if SERIO_CPP_VERSION >= 202302L
+    template <typename... Ts>
+    Derived& operator<<(const std::expected<Ts...>& value)  //
+    {
+        This() << value.has_value();
+
+        if (value.has_value())
+            return This() << value.value();
+        else
+            return This() << value.error();
+    }
+#endif
+
+#if SERIO_ENABLE_FILESYSTEM
+    Derived& operator<<(const std::filesystem::path& value)  //
+    {
+        path(value, std::is_same<std::filesystem::path::string_type, std::string>());
+        return This();
+    }
+#endif
+
+    template <typename Head, typename... Tail>
+    Derived& process(Head&& head, Tail&&... tail)
+    {
+        This() << std::forward<Head>(head);
+        return process(std::forward<Tail>(tail)...);
+    }
+    Derived& process() { return This(); }
+};
+
+template <typename Derived>
+class DeserializerOps : public Base::Deserializer, public Base::Binary
+{
+    Derived& This() { return (Derived&)*this; }
+
+    // The shared objects read so far in order of appearance, with the types they were read as.
+    using Tracked = std::vector<std::pair<std::shared_ptr<void>, const void*>>;
+    std::unique_ptr<Tracked> tracked;
+
+    template <typename T>
+    using Hoist = HoistFixed<T, Derived>;
+
+    template <typename T>
+    Derived& hoist(T& value, std::true_type)
+    {
+        This().readFixed(&value, 1);
+        return This();
+    }
+    template <typename T>
+    Derived& hoist(T& value, std::false_type)
+    {
+        return plain(value);
+    }
+    template <typename T>
+    Derived& plain(T& value)
+    {
+        return table(value, IsTable<T, Derived>());
+    }
+    template <typename T>
+    Derived& table(T& value, std::true_type)
+    {
+        This().readTable(value);
+        return This();
+    }
+    template <typename T>
+    Derived& table(T& value, std::false_type)
+    {
+        CustomClass<T>().deserialize(value, This());
+        return This();
+    }
+    template <typename T1, typename T2>
+    Derived& plain(std::pair<T1, T2>& value)
+    {
+        return This() >> value.first >> value.second;
+    }
+    template <typename... Ts>
+    Derived& plain(std::tuple<Ts...>& value)
+    {
+        Tuple<sizeof...(Ts)>::deserialize(This(), value);
+        return This();
+    }
+    template <typename It>
+    void items(It it, Size count, std::true_type)
+    {
+        This().readFixed(it, count);
+    }
+    template <typename It>
+    void items(It it, Size count, std::false_type)
+    {
+        for (; count > 0; --count, ++it) This() >> *it;
+    }
+    template <typename T>
+    void bulk(T* data, Size count, BulkTag<BulkMode::Copy>)
+    {
+        This().read(data, count);
+    }
+    template <typename T>
+    void bulk(T* data, Size count, BulkTag<BulkMode::Swap>)
     {
-        Size len = buffer.size();
-        buffer.append(size, 0);
-        return (char*)buffer.data() + len;
+        using Unit = SwapUnit<T>;
+        This().read(data, count);
+        ByteSwap<Unit::value>::copy((char*)data, (const char*)data, count * (sizeof(T) / Unit::value));
     }
-
-    std::string& buffer;
-
-public:
-    SerializerBase(std::string& buffer) : buffer(buffer) { buffer.reserve(1024); }
-
+    // Binds `count` elements of `T` to the input in place, which needs them stored as in memory.
     template <typename T>
-    EnableIfT<std::is_arithmetic<T>::value || std::is_enum<T>::value, Derived&> operator<<(const T& value)
+    const T* lend(Size count, BulkTag<BulkMode::Copy>)
     {
-        BasicType::serialize(take(sizeof(value)), value);
-        return This();
+        return (const T*)This().borrow(count * sizeof(T), alignof(T));
     }
-    template <typename... Ts>
-    Derived& operator<<(const std::basic_string<char, Ts...>& value)
+    template <typename T, BulkMode M>
+    const T* lend(Size, BulkTag<M>)
     {
-        This() << containerSize(value);
-        this->write(value.data(), value.size());
-        return This();
+        SERIO_ASSERT(false, "View elements are not stored as they are in memory");
+        return nullptr;
     }
-    template <size_t N>
-    Derived& operator<<(const std::bitset<N>& value)
+    template <typename T>
+    const T* lend(Size count)
     {
-        Bitset::serialize(take((N + 7) / 8), value);
-        return This();
+        using Type = typename std::remove_const<T>::type;
+        return lend<T>(count, BulkTag<IsBulk<Type>::value ? BulkFor<Type, Derived>::value : BulkMode::None>());
     }
-    template <typename... Ts>
-    Derived& operator<<(const std::vector<bool, Ts...>& value)
+    template <typename T>
+    void bulk(T* data, Size count, BulkTag<BulkMode::None>)
     {
-        This() << Size(value.size());
-        Bitset::serialize(take((value.size() + 7) / 8), value);
-        return This();
+        items(data, count, std::false_type());
     }
-    void write(const void* data, Size len) { buffer.append((const char*)data, len); }
-
-#if SERIO_CPP_VERSION >= 201703L
-    template <typename... Ts>
-    Derived& operator<<(const std::basic_string_view<char, Ts...>& value)
+    template <typename T>
+    void reserve(T& value, Size size, std::true_type)
     {
-        This() << containerSize(value);
-        this->write(value.data(), value.size());
-        return This();
+        value.reserve(size);
     }
-#endif
-};
-
-template <typename Derived>
-struct StreamSerializerBase
-{
-    std::vector<char> _buffer;
-    std::ostream& _stream;
-    Derived& This() { return (Derived&)*this; }
-
-public:
-    StreamSerializerBase(std::ostream& stream) : _stream(stream) { _buffer.resize(16); }
-
     template <typename T>
-    EnableIfT<std::is_arithmetic<T>::value || std::is_enum<T>::value, Derived&> operator<<(const T& value)
+    void reserve(T&, Size, std::false_type)
     {
-        BasicType::serialize(_buffer.data(), value);
-        write(_buffer.data(), sizeof(value));
-        return This();
     }
-    template <typename... Ts>
-    Derived& operator<<(const std::basic_string<char, Ts...>& value)
+    // Elements go in at the end, which ordered containers take in constant time when the input is
+    // sorted, as it is when they wrote it. Map values are read straight into their element.
+    template <typename T>
+    void append(T& value, std::true_type)
     {
-        auto size = value.size();
-        This() << Size(size);
-        write(value.data(), value.size());
-        return This();
+        auto it = value.emplace_hint(value.end(), std::piecewise_construct,
+                                     std::forward_as_tuple(this->get<typename T::key_type>()), std::forward_as_tuple());
+        This() >> it->second;
     }
-    template <size_t N>
-    Derived& operator<<(const std::bitset<N>& value)
+    template <typename T>
+    void append(T& value, std::false_type)
     {
-        auto size = size_t((N + 7) / 8);
-        if (size == 0) return This();
-        if (size > _buffer.size()) _buffer.resize(size);
-        Bitset::serialize(&_buffer.front(), value);
-        write(_buffer.data(), size);
+        value.emplace_hint(value.end(), this->get<typename ValueType<T>::Type>());
+    }
+    // Reads the new elements into the nodes of the old ones, allocating only for those beyond them.
+    template <typename T>
+    Derived& recycle(T& value, Size size, std::true_type)
+    {
+        T spare(std::move(value));
+        value.clear();
+        reserve(value, size, HasReserve<T>());
+        for (; size > 0 && !spare.empty(); --size)
+        {
+            auto node = spare.extract(spare.begin());
+            refill(node, IsMap<T>());
+            value.insert(value.end(), std::move(node));
+        }
+        for (; size > 0; --size) append(value, IsMap<T>());
         return This();
     }
-    template <typename... Ts>
-    Derived& operator<<(const std::vector<bool, Ts...>& value)
+    template <typename T>
+    Derived& recycle(T& value, Size size, std::false_type)
     {
-        This() << Size(value.size());
-        if (value.size() == 0) return This();
-        auto size = size_t((value.size() + 7) / 8);
-        if (size > _buffer.size()) _buffer.resize(size);
-        Bitset::serialize(&_buffer.front(), value);
-        write(_buffer.data(), size);
+        value.clear();
+        reserve(value, size, HasReserve<T>());
+        for (; size > 0; --size) append(value, IsMap<T>());
         return This();
     }
-    void write(const void* data, Size len)  //
+    template <typename Node>
+    void refill(Node& node, std::true_type)
     {
-        if (len > 0) _stream.rdbuf()->sputn((const char*)data, len);
+        This() >> node.key() >> node.mapped();
     }
-
-#if SERIO_CPP_VERSION >= 201703L
-    template <typename... Ts>
-    Derived& operator<<(const std::basic_string_view<char, Ts...>& value)
+    template <typename Node>
+    void refill(Node& node, std::false_type)
     {
-        This() << containerSize(value);
-        this->write(value.data(), value.size());
-        return This();
+        This() >> node.value();
+    }
+    // Reads into the object a pointer already holds, when nobody else owns it and it can't be of a
+    // derived class. Returns false when a new object is needed.
+    template <typename T, typename... Ts>
+    bool reread(std::unique_ptr<T, Ts...>& value)
+    {
+        using Reusable = std::integral_constant<bool, !std::is_const<T>::value && !std::is_polymorphic<T>::value>;
+        return reread(value, Reusable());
     }
-#endif
-};
-
-template <typename Derived>
-class DeserializerBase
-{
-    const char* start{nullptr};
-    const char* buffer{nullptr};
-    Size length{0};
-    Size maxLength{0};
-
     template <typename T>
-    T get()
+    bool reread(T&)
     {
-        T value;
-        This() >> value;
-        return value;
+        return false;
     }
-
-    void advance(Size size)
+    template <typename T>
+    bool reread(T& value, std::true_type)
     {
-        this->buffer += size;
-        this->length -= size;
+        if (!value) return false;
+        This() >> *value;
+        return true;
     }
-
-    Derived& This() { return (Derived&)*this; }
-
-public:
-    DeserializerBase(const char* ptr, Size length, Size maxLength)
-        : start(ptr), buffer(ptr), length(length), maxLength(maxLength)
+    template <typename T>
+    bool reread(T&, std::false_type)
     {
+        return false;
     }
-
-    Size progress() { return buffer - start; }
-
-    Size getLength()
+    // Moves past values without constructing them. Values of a fixed wire size are stepped over at
+    // once; the others are taken apart by type through `step()`.
+    template <typename T>
+    void pass(Skip<T> tag)
     {
-        auto size = this->get<Size>();
-        if (maxLength > 0) SERIO_ASSERT(size <= maxLength, "Requested container size above maximum limit");
-        return size;
+        pass(tag, Hoist<T>());
     }
-
     template <typename T>
-    EnableIfT<std::is_arithmetic<T>::value || std::is_enum<T>::value, Derived&> operator>>(T& value)
+    void pass(Skip<T>, std::true_type)
     {
-        SERIO_ASSERT(length >= sizeof(value), "Requested structure doesn't match the input buffer");
-        BasicType::deserialize(this->buffer, value);
-        advance(sizeof(value));
-        return This();
+        This().skip(WireSize<T>::value);
     }
-    template <typename... Ts>
-    Derived& operator>>(std::basic_string<char, Ts...>& value)
+    template <typename T>
+    void pass(Skip<T> tag, std::false_type)
     {
-        value.resize(getLength());
-        SERIO_ASSERT(length >= value.size(), "Requested structure doesn't match the input buffer");
-        std::copy(this->buffer, this->buffer + value.size(), &value[0]);
-        advance(value.size());
-        return This();
+        step(tag);
     }
-    template <size_t N>
-    Derived& operator>>(std::bitset<N>& value)
+    template <typename Head, typename... Tail>
+    void sequence(Skip<Head> head, Skip<Tail>... tail)
     {
-        size_t size = (N + 7) / 8;
-        SERIO_ASSERT(length >= size, "Requested structure doesn't match the input buffer");
-        Bitset::deserialize(this->buffer, value);
-        advance(size);
-        return This();
+        pass(head);
+        sequence(tail...);
+    }
+    void sequence() {}
+    // Moves past `count` elements, all at once when each takes `width` bytes and one by one when
+    // `width` is zero.
+    template <typename T>
+    void elements(Size count, Size width)
+    {
+        if (width == 0)
+            for (; count > 0; --count) pass(Skip<T>());
+        else
+        {
+            SERIO_ASSERT(count <= Size(-1) / width, "Requested structure doesn't match the input buffer");
+            This().skip(count * width);
+        }
     }
     template <typename... Ts>
-    Derived& operator>>(std::vector<bool, Ts...>& value)
+    void members(Members<Ts...>, std::false_type)
     {
-        value.resize(getLength());
-        size_t size = (value.size() + 7) / 8;
-        SERIO_ASSERT(length >= size, "Requested structure doesn't match the input buffer");
-        Bitset::deserialize(this->buffer, value);
-        advance(size);
-        return This();
+        sequence(Skip<Ts>()...);
+    }
+    template <typename... Ts>
+    void members(Members<Ts...>, std::true_type)
+    {
+        auto size = this->get<Size>();
+        SERIO_ASSERT(size >= sizeof(Size), "Flat table doesn't match the registered members");
+        This().skip(size - sizeof(Size));
     }
+    // Types whose layout is up to their `CustomClass`, and scalars, are decoded into a temporary.
     template <typename T>
-    void read(T* data, Size len)
+    EnableIfT<!IsRegistered<T>::value && !IsContinuous<T>::value && !IsResizable<T>::value &&
+              !IsAppendable<T>::value && !IsPointer<T>::value && !IsOptional<T>::value>
+    step(Skip<T>)
     {
-        len *= sizeof(T);
-        SERIO_ASSERT(length >= len, "Requested structure doesn't match the input buffer");
-        std::memcpy((void*)data, this->buffer, len);
-        advance(len);
+        this->get<T>();
     }
-};
-
-template <typename Derived>
-struct StreamDeserializerBase
-{
-    std::vector<char> _buffer;
-    std::istream& _stream;
-    Size _maxLength{0};
-
     template <typename T>
-    T get()
+    EnableIfT<IsRegistered<T>::value> step(Skip<T>)
     {
-        T value;
-        This() >> value;
-        return value;
+        members(MembersOf<T>(), IsTable<T, Derived>());
     }
-
-    Derived& This() { return (Derived&)*this; }
-
-public:
-    StreamDeserializerBase(std::istream& stream, Size maxLength) : _stream(stream), _maxLength(maxLength)
+    template <typename T>
+    EnableIfT<IsContinuous<T>::value && !IsFixed<T>::value> step(Skip<T>)
     {
-        _buffer.resize(16);
+        using Type = typename T::value_type;
+        elements<Type>(This().getLength(), Derived::Encoding::template Bulk<Type>::value ? sizeof(Type) : 0);
     }
-
-    Size getLength()
+    template <typename T>
+    EnableIfT<IsResizable<T>::value && !IsContinuous<T>::value> step(Skip<T>)
     {
-        auto size = this->get<Size>();
-        if (_maxLength > 0) SERIO_ASSERT(size <= _maxLength, "Requested container size above maximum limit");
-        return size;
+        using Type = typename T::value_type;
+        elements<Type>(This().getLength(), Hoist<Type>::value ? WireSize<Type>::value : 0);
     }
-
     template <typename T>
-    EnableIfT<std::is_arithmetic<T>::value || std::is_enum<T>::value, Derived&> operator>>(T& value)
+    EnableIfT<IsAppendable<T>::value> step(Skip<T>)
     {
-        read(_buffer.data(), sizeof(value));
-        BasicType::deserialize(_buffer.data(), value);
-        return This();
+        using Type = typename ValueType<T>::Type;
+        elements<Type>(This().getLength(), Hoist<Type>::value ? WireSize<Type>::value : 0);
+    }
+    template <typename T, size_t N>
+    void step(Skip<std::array<T, N>>)
+    {
+        elements<T>(N, IsBulk<T>::value && Derived::Encoding::template Bulk<T>::value ? sizeof(T)
+                       : Hoist<T>::value                                               ? WireSize<T>::value
+                                                                                       : 0);
     }
     template <typename... Ts>
-    Derived& operator>>(std::basic_string<char, Ts...>& value)
+    void step(Skip<std::vector<bool, Ts...>>)
     {
-        auto size = getLength();
-        value.resize(size);
-        if (size > 0) read(&value.front(), value.size());
-        return This();
+        This().skip((This().getLength() + 7) / 8);
     }
     template <size_t N>
-    Derived& operator>>(std::bitset<N>& value)
+    void step(Skip<std::bitset<N>>)
     {
-        auto size = size_t((N + 7) / 8);
-        if (size == 0) return This();
-        if (size > _buffer.size()) _buffer.resize(size);
-        read(&_buffer.front(), size);
-        Bitset::deserialize(_buffer.data(), value);
-        return This();
+        This().skip((N + 7) / 8);
+    }
+    // Tracked objects are built even when skipped, since later pointers may refer back to them.
+    template <typename T>
+    EnableIfT<IsPointer<T>::value> step(Skip<T>)
+    {
+        using Type = typename std::remove_const<typename T::element_type>::type;
+        T value;
+        if (tracked && share(value)) return;
+        if (this->get<bool>()) pointee(Skip<Type>(), HasDerived<Type>());
+    }
+    template <typename T>
+    void pointee(Skip<T> tag, std::false_type)
+    {
+        pass(tag);
+    }
+    template <typename T>
+    void pointee(Skip<T>, std::true_type)
+    {
+        derived(typename PolymorphicTypes<T>::Types());
     }
     template <typename... Ts>
-    Derived& operator>>(std::vector<bool, Ts...>& value)
+    void derived(DerivedTypes<Ts...>)
     {
-        value.resize(getLength());
-        if (value.size() == 0) return This();
-        auto size = size_t((value.size() + 7) / 8);
-        if (size > _buffer.size()) _buffer.resize(size);
-        read(&_buffer.front(), size);
-        Bitset::deserialize(_buffer.data(), value);
-        return This();
+        using Step = Derived& (DeserializerOps::*)();
+        static const Step steps[] = {&DeserializerOps::skip<Ts>...};
+        auto id = this->get<Size>();
+        SERIO_ASSERT(id < sizeof...(Ts), "Invalid derived class id");
+        (this->*steps[id])();
     }
     template <typename T>
-    void read(T* data, Size len)
+    EnableIfT<IsOptional<T>::value> step(Skip<T>)
     {
-        len *= sizeof(T);
-        auto size = _stream.rdbuf()->sgetn((char*)data, len);
-        SERIO_ASSERT(size == len, "Requested structure doesn't match the input stream");
+        if (this->get<bool>()) pass(Skip<typename T::value_type>());
     }
-};
-
-template <typename Derived>
-class SerializerOps : public Base::Serializer, public Base::Binary
-{
-    Derived& This() { return (Derived&)*this; }
-
-public:
     template <typename T>
-    EnableIfT<std::is_class<T>::value && !IsFixed<T>::value && !IsResizable<T>::value && !IsAppendable<T>::value &&
-                  !IsPointer<T>::value && !IsOptional<T>::value,
-              Derived&>
-    operator<<(const T& value)
+    void step(Skip<IndexedView<T>>)
     {
-        CustomClass<T>().serialize(value, This());
-        return This();
+        elements<char>(This().getLength(), sizeof(Size));
+        char total[sizeof(Size)];
+        This().read(total, sizeof(total));
+        Size size = 0;
+        BasicType::deserialize(total, size);
+        This().skip(size);
+    }
+    template <typename... Ts>
+    void step(Skip<std::queue<Ts...>>)
+    {
+        pass(Skip<typename std::queue<Ts...>::container_type>());
+    }
+    template <typename... Ts>
+    void step(Skip<std::stack<Ts...>>)
+    {
+        pass(Skip<typename std::stack<Ts...>::container_type>());
+    }
+    template <typename... Ts>
+    void step(Skip<std::priority_queue<Ts...>>)
+    {
+        pass(Skip<typename std::priority_queue<Ts...>::container_type>());
+    }
+    template <typename T1, typename T2>
+    void step(Skip<std::pair<T1, T2>>)
+    {
+        sequence(Skip<T1>(), Skip<T2>());
+    }
+    template <typename... Ts>
+    void step(Skip<std::tuple<Ts...>>)
+    {
+        sequence(Skip<Ts>()...);
     }
     template <typename T>
-    EnableIfT<IsContinuous<T>::value, Derived&> operator<<(const T& value)
+    void step(Skip<std::complex<T>>)
+    {
+        sequence(Skip<T>(), Skip<T>());
+    }
+    template <typename T>
+    void step(Skip<std::atomic<T>>)
+    {
+        pass(Skip<T>());
+    }
+    template <typename... Ts>
+    void step(Skip<std::chrono::duration<Ts...>>)
+    {
+        pass(Skip<typename std::chrono::duration<Ts...>::rep>());
+    }
+    template <typename... Ts>
+    void step(Skip<std::chrono::time_point<Ts...>>)
+    {
+        pass(Skip<typename std::chrono::time_point<Ts...>::duration>());
+    }
+
+#if SERIO_CPP_VERSION >= 201703L
+    template <typename... Ts>
+    void step(Skip<std::variant<Ts...>>)
+    {
+        using Step = Derived& (DeserializerOps::*)();
+        static const Step steps[] = {&DeserializerOps::skip<Ts>...};
+        auto index = this->get<Size>();
+        SERIO_ASSERT(index < sizeof...(Ts), "Invalid variant index");
+        (this->*steps[index])();
+    }
+#endif
+
+#if SERIO_CPP_VERSION >= 202302L
+    template <typename T, typename E>
+    void step(Skip<std::expected<T, E>>)
     {
-        if (!IsFixed<T>::value) This() << containerSize(value);
-        if (littleEndian())
-            This().write(value.data(), value.size() * sizeof(typename T::value_type));
+        if (this->get<bool>())
+            pass(Skip<T>());
         else
-            for (const auto& item : value) This() << item;
-        return This();
+            pass(Skip<E>());
     }
+#endif
+
+#if SERIO_ENABLE_FILESYSTEM
+    void step(Skip<std::filesystem::path>) { pass(Skip<std::string>()); }
+#endif
+    // Wrappers hold a reference to their value, so the wrapped type is skipped instead.
     template <typename T>
-    EnableIfT<(IsFixed<T>::value || IsResizable<T>::value || IsAppendable<T>::value) && !IsContinuous<T>::value,
-              Derived&>
-    operator<<(const T& value)
+    void step(Skip<NVP<T>>)
     {
-        if (!IsFixed<T>::value) This() << containerSize(value);
-        for (const auto& item : value) This() << item;
-        return This();
+        pass(Skip<typename std::decay<T>::type>());
     }
     template <typename T>
-    EnableIfT<IsPointer<T>::value, Derived&> operator<<(const T& value)
-    {
-        This() << bool(value);
-        if (value) This() << *value.get();
-        return This();
-    }
-    template <typename... Ts>
-    Derived& operator<<(const std::chrono::duration<Ts...>& value)
-    {
-        return This() << value.count();
-    }
-    template <typename... Ts>
-    Derived& operator<<(const std::chrono::time_point<Ts...>& value)
+    void step(Skip<BinaryString<T>>)
     {
-        return This() << value.time_since_epoch();
+        pass(Skip<typename std::decay<T>::type>());
     }
+
     template <typename T>
-    Derived& operator<<(const std::weak_ptr<T>& value)
+    T build(std::false_type)
     {
-        return This() << value.lock();
+        T value;
+        This() >> value;
+        return value;
     }
-    template <typename... Ts>
-    Derived& operator<<(const std::queue<Ts...>& value)
+#if SERIO_ENABLE_PMR
+    // Values that take memory from a resource are created on the one given to the deserializer.
+    template <typename T>
+    T build(std::true_type)
     {
-        return This() << static_cast<const Queue<Ts...>&>(value).c;
+        auto resource = This().memoryResource();
+        T value(std::pmr::polymorphic_allocator<char>(resource ? resource : std::pmr::get_default_resource()));
+        This() >> value;
+        return value;
     }
-    template <typename... Ts>
-    Derived& operator<<(const std::stack<Ts...>& value)
+    // Shared pointees come from the resource given to the deserializer. `std::unique_ptr` can't give
+    // memory back to one, so its pointees always come from the heap.
+    template <typename T>
+    bool allocate(std::shared_ptr<T>& value)
     {
-        return This() << static_cast<const Stack<Ts...>&>(value).c;
+        using Type = typename std::remove_const<T>::type;
+        auto resource = This().memoryResource();
+        if (!resource) return false;
+        auto item = std::allocate_shared<Type>(std::pmr::polymorphic_allocator<Type>(resource));
+        This() >> *item;
+        value = std::move(item);
+        return true;
     }
-    template <typename... Ts>
-    Derived& operator<<(const std::priority_queue<Ts...>& value)
+#endif
+    template <typename T>
+    bool allocate(T&)
     {
-        return This() << static_cast<const PQueue<Ts...>&>(value).c;
+        return false;
     }
-    template <typename T1, typename T2>
-    Derived& operator<<(const std::pair<T1, T2>& value)
+    // Creates the object of a tracked pointer, on the resource given to the deserializer if any.
+    template <typename T>
+    std::shared_ptr<T> create()
     {
-        return This() << value.first << value.second;
+#if SERIO_ENABLE_PMR
+        auto resource = This().memoryResource();
+        if (resource) return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(resource));
+#endif
+        return std::make_shared<T>();
     }
-    template <typename... Ts>
-    Derived& operator<<(const std::tuple<Ts...>& value)
+    // Reads what `SerializerOps::share()` writes. A new object is recorded before it is read, so
+    // pointers inside it may refer back to it.
+    template <typename T>
+    bool share(std::shared_ptr<T>& value)
     {
-        Tuple<sizeof...(Ts)>::serialize(This(), value);
-        return This();
+        using Type = typename std::remove_const<T>::type;
+        auto id = this->get<Size>();
+        if (id == 0)
+            value.reset();
+        else if (id == 1)
+            emplace(value, HasDerived<Type>());
+        else
+        {
+            SERIO_ASSERT(id - 2 < tracked->size(), "Invalid shared pointer reference");
+            const auto& entry = (*tracked)[id - 2];
+            SERIO_ASSERT(entry.second == typeTag<Type>(), "Shared pointer refers to an object of another type");
+            value = std::static_pointer_cast<Type>(entry.first);
+        }
+        return true;
     }
     template <typename T>
-    Derived& operator<<(const std::complex<T>& value)
+    bool share(T&)
     {
-        return This() << value.real() << value.imag();
+        return false;
     }
-    template <typename... Ts>
-    Derived& operator<<(const std::atomic<Ts...>& value)
+    // Creates the object of a pointer and reads it. Tracked objects are recorded before they are
+    // read, so pointers inside them may refer back to them.
+    template <typename T>
+    void emplace(std::shared_ptr<T>& value, std::false_type)
     {
-        return This() << value.load();
+        if (tracked)
+            make<typename std::remove_const<T>::type>(value);
+        else
+            construct(value);
     }
-    template <typename T>
-    Derived& operator<<(const BinaryString<T>& value)
+    template <typename T, typename... Ts>
+    void emplace(std::unique_ptr<T, Ts...>& value, std::false_type)
     {
-        return This() << value.value;
+        construct(value);
     }
     template <typename T>
-    Derived& operator<<(const NVP<T>& value)
+    void construct(T& value)
     {
-        return This() << value.value;
+        if (This().reusing() && reread(value)) return;
+        if (allocate(value)) return;
+        auto* item = new typename std::remove_const<typename T::element_type>::type;
+        This() >> *item;
+        value.reset(item);
     }
-
-#if SERIO_CPP_VERSION >= 201703L
+    // Objects behind pointers to a class with derived classes listed are created by the id of
+    // their class, through a table indexed by it.
     template <typename T>
-    EnableIfT<IsOptional<T>::value, Derived&> operator<<(const T& value)
+    void emplace(T& value, std::true_type)
     {
-        This() << value.has_value();
-        if (value.has_value()) This() << value.value();
-        return This();
+        using Type = typename std::remove_const<typename T::element_type>::type;
+        derived(value, typename PolymorphicTypes<Type>::Types());
     }
-    template <typename... Ts>
-    Derived& operator<<(const std::variant<Ts...>& value)
+    template <typename T, typename... Ts>
+    void derived(T& value, DerivedTypes<Ts...>)
     {
-        This() << Size(value.index());
-        std::visit([&](auto&& arg) { This() << arg; }, value);
-        return This();
+        using Make = void (DeserializerOps::*)(T&);
+        static const Make makes[] = {&DeserializerOps::make<Ts>...};
+        auto id = this->get<Size>();
+        SERIO_ASSERT(id < sizeof...(Ts), "Invalid derived class id");
+        (this->*makes[id])(value);
     }
-    Derived& operator<<(const std::monostate&)  //
+    template <typename U, typename T, typename... Ts>
+    void make(std::unique_ptr<T, Ts...>& value)
     {
-        return This();
+        std::unique_ptr<U> item(new U);
+        This() >> *item;
+        value.reset(item.release());
     }
-#endif
-
-#if SERIO_CPP_VERSION >= 202302L
-    template <typename... Ts>
-    Derived& operator<<(const std::expected<Ts...>& value)  //
+    template <typename U, typename T>
+    void make(std::shared_ptr<T>& value)
     {
-        This() << value.has_value();
-
-        if (value.has_value())
-            return This() << value.value();
-        else
-            return This() << value.error();
+        using Type = typename std::remove_const<T>::type;
+        auto item = create<U>();
+        std::shared_ptr<Type> base = item;
+        if (tracked) tracked->emplace_back(base, typeTag<Type>());
+        value = std::move(base);
+        This() >> *item;
     }
-#endif
 
-#if SERIO_ENABLE_FILESYSTEM
-    Derived& operator<<(const std::filesystem::path& value)  //
+public:
+    /// Turns pointer tracking on or off, which must match how the input was written. See
+    /// `SerializerOps::tracking()`.
+    Derived& tracking(bool on)
     {
-        return This() << value.string();
+        tracked.reset(on ? new Tracked() : nullptr);
+        return This();
     }
-#endif
 
-    template <typename Head, typename... Tail>
-    Derived& process(Head&& head, Tail&&... tail)
+    template <typename T>
+    T get()
     {
-        This() << std::forward<Head>(head);
-        return process(std::forward<Tail>(tail)...);
+        return build<T>(UsesResource<T>());
     }
-    Derived& process() { return This(); }
-};
-
-template <typename Derived>
-class DeserializerOps : public Base::Deserializer, public Base::Binary
-{
-    Derived& This() { return (Derived&)*this; }
 
-public:
+    /// Moves past a serialized `T` without constructing it. Strings and containers of fixed-size
+    /// elements are stepped over using their length prefix, and so are the tables of the flat
+    /// format. Types serialized by a hand-written `CustomClass` are decoded into a temporary.
     template <typename T>
-    T get()
+    Derived& skip()
     {
-        T value;
-        This() >> value;
-        return value;
+        pass(Skip<T>());
+        return This();
     }
 
     template <typename T>
@@ -517,74 +2326,97 @@ public:
               Derived&>
     operator>>(T& value)
     {
-        CustomClass<T>().deserialize(value, This());
-        return This();
+        return hoist(value, Hoist<T>());
     }
     template <typename T>
     EnableIfT<IsFixedContinuous<T>::value, Derived&> operator>>(T& value)
     {
-        if (littleEndian())
-            This().read(value.data(), value.size());
-        else
-            for (auto& item : value) This() >> item;
+        static_assert(IsBulkSafe<typename T::value_type>::value, "Type is not trivially serializable.");
+        bulk(value.data(), value.size(), BulkFor<typename T::value_type, Derived>());
         return This();
     }
     template <typename T>
     EnableIfT<IsContinuous<T>::value && !IsFixedContinuous<T>::value, Derived&> operator>>(T& value)
     {
+        static_assert(IsBulkSafe<typename T::value_type>::value, "Type is not trivially serializable.");
         value.resize(This().getLength());
-        if (littleEndian())
-            This().read(value.data(), value.size());
-        else
-            for (auto& item : value) This() >> item;
+        bulk(value.data(), value.size(), BulkFor<typename T::value_type, Derived>());
         return This();
     }
     template <typename T>
     EnableIfT<IsFixed<T>::value && !IsContinuous<T>::value, Derived&> operator>>(T& value)
     {
-        for (auto& item : value) This() >> item;
+        using Type = typename std::iterator_traits<decltype(std::begin(value))>::value_type;
+        items(std::begin(value), containerSize(value), Hoist<Type>());
         return This();
     }
     template <typename T>
     EnableIfT<IsResizable<T>::value && !IsContinuous<T>::value, Derived&> operator>>(T& value)
     {
+        using Type = typename std::iterator_traits<decltype(std::begin(value))>::value_type;
         value.resize(This().getLength());
-        for (auto& item : value) This() >> item;
+        items(std::begin(value), containerSize(value), Hoist<Type>());
         return This();
     }
     template <typename T>
     EnableIfT<IsAppendable<T>::value, Derived&> operator>>(T& value)
     {
-        using Type = typename ValueType<T>::Type;
-        value.clear();
         auto size = This().getLength();
-        for (Size i = 0; i < size; ++i) value.emplace_hint(value.end(), this->get<Type>());
+        if (This().reusing() && !value.empty()) return recycle(value, size, HasExtract<T>());
+        value.clear();
+        reserve(value, size, HasReserve<T>());
+        for (Size i = 0; i < size; ++i) append(value, IsMap<T>());
         return This();
     }
     template <typename T, Size N>
     Derived& operator>>(StaticArrayView<T, N> value)
     {
-        if (std::is_arithmetic<T>::value && littleEndian())
-            This().read(value.data(), value.size());
-        else
-            for (auto& item : value) This() >> item;
+        static_assert(!IsBulk<T>::value || IsBulkSafe<T>::value, "Type is not trivially serializable.");
+        bulk(value.data(), value.size(), BulkTag<IsBulk<T>::value ? BulkFor<T, Derived>::value : BulkMode::None>());
+        return This();
+    }
+    template <typename T>
+    Derived& operator>>(Indexed<T> value)
+    {
+        using Type = typename std::decay<decltype(*std::begin(value.value))>::type;
+        value.value.resize(This().getLength());
+        char scratch[64 * sizeof(Size)];
+        for (Size left = (value.value.size() + 1) * sizeof(Size); left > 0;)
+        {
+            Size size = std::min<Size>(left, sizeof(scratch));
+            This().read(scratch, size);
+            left -= size;
+        }
+        items(std::begin(value.value), value.value.size(), Hoist<Type>());
+        return This();
+    }
+    template <typename T>
+    Derived& operator>>(IndexedView<T>& value)
+    {
+        auto count = This().getLength();
+        SERIO_ASSERT(count < Size(-1) / sizeof(Size), "Requested structure doesn't match the input buffer");
+        auto table = This().borrow((count + 1) * sizeof(Size), 1);
+        Size size = 0;
+        BasicType::deserialize(table + count * sizeof(Size), size);
+        auto data = This().borrow(size, 1);
+        value = IndexedView<T>(table, data, count, This().lengthLimit(), &readIndexed<Derived, T>);
         return This();
     }
     template <typename T>
     Derived& operator>>(PointerView<T>& value)
     {
-        static_assert(std::is_same<decltype(value), PointerView<T>>::value, "Pointer view is not deserializable.");
+        static_assert(std::is_const<T>::value, "Only pointer views of const elements are deserializable.");
+        auto size = This().getLength();
+        value = PointerView<T>(lend<T>(size), size);
         return This();
     }
     template <typename T>
     EnableIfT<IsPointer<T>::value, Derived&> operator>>(T& value)
     {
+        using Type = typename std::remove_const<typename T::element_type>::type;
+        if (tracked && share(value)) return This();
         if (this->get<bool>())
-        {
-            auto* item = new typename std::remove_const<typename T::element_type>::type;
-            This() >> *item;
-            value.reset(item);
-        }
+            emplace(value, HasDerived<Type>());
         else
             value.reset();
 
@@ -630,13 +2462,12 @@ public:
     template <typename T1, typename T2>
     Derived& operator>>(std::pair<T1, T2>& value)
     {
-        return This() >> value.first >> value.second;
+        return hoist(value, Hoist<std::pair<T1, T2>>());
     }
     template <typename... Ts>
     Derived& operator>>(std::tuple<Ts...>& value)
     {
-        Tuple<sizeof...(Ts)>::deserialize(This(), value);
-        return This();
+        return hoist(value, Hoist<std::tuple<Ts...>>());
     }
     template <typename T>
     Derived& operator>>(std::complex<T>& value)
@@ -661,22 +2492,29 @@ public:
     {
         return This() >> value.value;
     }
+    template <typename T>
+    Derived& operator>>(Skip<T>)
+    {
+        return skip<T>();
+    }
 
 #if SERIO_CPP_VERSION >= 201703L
-    template <typename... Ts>
-    Derived& operator>>(std::basic_string_view<Ts...>& value)
+    template <typename T, typename... Ts>
+    Derived& operator>>(std::basic_string_view<T, Ts...>& value)
     {
-        static_assert(std::is_same<decltype(value), std::basic_string_view<Ts...>>::value,
-                      "String view is not deserializable.");
+        auto size = This().getLength();
+        value = std::basic_string_view<T, Ts...>(lend<T>(size), size);
         return This();
     }
     template <typename T>
     EnableIfT<IsOptional<T>::value, Derived&> operator>>(T& value)
     {
-        if (this->get<bool>())
-            value.emplace(this->get<typename T::value_type>());
-        else
+        if (!this->get<bool>())
             value.reset();
+        else if (This().reusing() && value)
+            This() >> *value;
+        else
+            value.emplace(this->get<typename T::value_type>());
 
         return This();
     }
@@ -699,7 +2537,9 @@ public:
     template <typename T, size_t S>
     Derived& operator>>(std::span<T, S>& value)
     {
-        static_assert(std::is_same<decltype(value), std::span<T, S>>::value, "Span is not deserializable.");
+        static_assert(std::is_const<T>::value, "Only spans of const elements are deserializable.");
+        Size size = S == std::dynamic_extent ? This().getLength() : Size(S);
+        value = std::span<T, S>(lend<T>(size), size);
         return This();
     }
 #endif
@@ -734,46 +2574,300 @@ public:
     Derived& process() { return This(); }
 };
 
-/// @brief This class serializes any of the supported types to buffer.
-struct Serializer : SerializerBase<Serializer>, SerializerOps<Serializer>
+/// @brief This class serializes any of the supported types to the output adapted by `Output`.
+template <typename Output, typename E = FixedEncoding>
+struct BasicSerializer : SerializerBase<BasicSerializer<Output, E>, Output, E>, SerializerOps<BasicSerializer<Output, E>>
+{
+    using Base = SerializerBase<BasicSerializer<Output, E>, Output, E>;
+    using Ops = SerializerOps<BasicSerializer<Output, E>>;
+    using Base::Base;
+    using Ops::operator<<;
+    using Base::operator<<;
+};
+
+/// @brief This class serializes any of the supported types to a string.
+using Serializer = BasicSerializer<StringOutput>;
+
+/// @brief This class serializes any of the supported types to a growable `BasicBuffer`.
+template <typename Allocator = std::allocator<char>, typename E = FixedEncoding>
+using BufferSerializer = BasicSerializer<BufferOutput<Allocator>, E>;
+
+/// @brief This class serializes any of the supported types to scatter-gather `Segments`.
+template <typename E = FixedEncoding>
+using SegmentSerializer = BasicSerializer<SegmentOutput, E>;
+
+#ifdef SERIO_UNIX
+/// @brief This class serializes any of the supported types into a memory-mapped file.
+template <typename E = FixedEncoding>
+using MappedSerializer = BasicSerializer<MappedOutput, E>;
+#endif
+
+/// @brief This class computes the number of bytes the binary serializer would produce, without
+/// writing any of them.
+template <typename E = FixedEncoding>
+struct BasicSizeSerializer : SizeSerializerBase<BasicSizeSerializer<E>, E>, SerializerOps<BasicSizeSerializer<E>>
+{
+    using Base = SizeSerializerBase<BasicSizeSerializer<E>, E>;
+    using Ops = SerializerOps<BasicSizeSerializer<E>>;
+    using Ops::operator<<;
+    using Base::operator<<;
+};
+
+using SizeSerializer = BasicSizeSerializer<>;
+
+/// @brief This class computes the number of bytes `FlatSerializer` would produce.
+struct FlatSizeSerializer : SizeSerializerBase<FlatSizeSerializer>, SerializerOps<FlatSizeSerializer>, FlatLayout
+{
+    using Base = SizeSerializerBase<FlatSizeSerializer>;
+    using Ops = SerializerOps<FlatSizeSerializer>;
+    using Ops::operator<<;
+    using Base::operator<<;
+
+    template <typename T>
+    void writeTable(const T& value)
+    {
+        write(nullptr, (2 + MemberCount<MembersOf<T>>::value) * sizeof(Size));
+        CustomClass<T>().serialize(value, *this);
+    }
+};
+
+/// @brief This class serializes fixed-size values into memory that was already sized for them.
+template <typename E = FixedEncoding>
+struct BasicUncheckedSerializer : SerializerBase<BasicUncheckedSerializer<E>, PointerOutput, E>,
+                                  SerializerOps<BasicUncheckedSerializer<E>>,
+                                  Unchecked
 {
-    using Base = SerializerBase<Serializer>;
-    using Ops = SerializerOps<Serializer>;
-    using Base::SerializerBase;
+    using Base = SerializerBase<BasicUncheckedSerializer<E>, PointerOutput, E>;
+    using Ops = SerializerOps<BasicUncheckedSerializer<E>>;
+    using Base::Base;
     using Ops::operator<<;
     using Base::operator<<;
 };
 
+using UncheckedSerializer = BasicUncheckedSerializer<>;
+
 /// @brief This class deserializes any of the supported types from buffer.
-struct Deserializer : DeserializerBase<Deserializer>, DeserializerOps<Deserializer>
+template <typename E = FixedEncoding>
+struct BasicDeserializer : DeserializerBase<BasicDeserializer<E>, E>, DeserializerOps<BasicDeserializer<E>>
 {
-    using Base = DeserializerBase<Deserializer>;
-    using Ops = DeserializerOps<Deserializer>;
+    using Base = DeserializerBase<BasicDeserializer<E>, E>;
+    using Ops = DeserializerOps<BasicDeserializer<E>>;
     using Base::Base;
     using Ops::operator>>;
     using Base::operator>>;
     using Ops::get;
+    using Ops::skip;
+    using Base::skip;
 };
 
-/// @brief This class serializes any of the supported types to stream.
-struct StreamSerializer : StreamSerializerBase<StreamSerializer>, SerializerOps<StreamSerializer>
+using Deserializer = BasicDeserializer<>;
+
+/// @brief This class deserializes any of the supported types from a buffer known to be well-formed,
+/// without checking lengths and bounds against the input. Malformed input is read out of bounds.
+template <typename E = FixedEncoding>
+struct BasicTrustedDeserializer : DeserializerBase<BasicTrustedDeserializer<E>, E>,
+                                  DeserializerOps<BasicTrustedDeserializer<E>>,
+                                  Trusted
+{
+    using Base = DeserializerBase<BasicTrustedDeserializer<E>, E>;
+    using Ops = DeserializerOps<BasicTrustedDeserializer<E>>;
+    using Base::Base;
+    using Ops::operator>>;
+    using Base::operator>>;
+    using Ops::get;
+    using Ops::skip;
+    using Base::skip;
+};
+
+#ifdef SERIO_UNIX
+/// @brief This class deserializes any of the supported types from a memory-mapped file, releasing
+/// the pages it has moved past as `MappedFile` is configured to.
+template <typename E = FixedEncoding>
+struct BasicMappedDeserializer : DeserializerBase<BasicMappedDeserializer<E>, E>,
+                                 DeserializerOps<BasicMappedDeserializer<E>>
+{
+    using Base = DeserializerBase<BasicMappedDeserializer<E>, E>;
+    using Ops = DeserializerOps<BasicMappedDeserializer<E>>;
+    using Ops::operator>>;
+    using Base::operator>>;
+    using Ops::get;
+    using Ops::skip;
+    using Base::skip;
+
+    MappedFile& file;
+
+    BasicMappedDeserializer(MappedFile& file, const char* ptr, Size length, Size maxLength, bool reuse = false,
+                            MemoryResource* resource = nullptr)
+        : Base(ptr, length, maxLength, false, reuse, resource), file(file)
+    {
+    }
+
+    void advanced(const char* ptr) { file.consumed(ptr); }
+};
+#endif
+
+/// @brief This class serializes any of the supported types to a string in the flat format. Registered
+/// classes of varying size are written as tables: their size in bytes, their member count and the
+/// offset of each member from the start of the table, followed by the members themselves.
+struct FlatSerializer : SerializerBase<FlatSerializer, StringOutput>, SerializerOps<FlatSerializer>, FlatLayout
+{
+    using Base = SerializerBase<FlatSerializer, StringOutput>;
+    using Ops = SerializerOps<FlatSerializer>;
+    using Ops::operator<<;
+    using Base::operator<<;
+
+    std::string& buffer;
+
+    FlatSerializer(std::string& buffer) : Base(buffer), buffer(buffer) {}
+
+    // Receives the members of a table from its `_serialize` and records where each one starts.
+    struct Table
+    {
+        FlatSerializer& C;
+        Size start, index;
+
+        template <typename Head, typename... Tail>
+        Table& process(const Head& head, const Tail&... tail)
+        {
+            BasicType::serialize(&C.buffer[start + (2 + index++) * sizeof(Size)], Size(C.buffer.size() - start));
+            C << head;
+            return process(tail...);
+        }
+        Table& process() { return *this; }
+    };
+
+    template <typename T>
+    void writeTable(const T& value)
+    {
+        Size count = MemberCount<MembersOf<T>>::value, start = buffer.size();
+        buffer.append((2 + count) * sizeof(Size), 0);
+        Table table{*this, start, 0};
+        CustomClass<T>().serialize(value, table);
+        SERIO_ASSERT(table.index == count, "Class wrote other members than it registered");
+        BasicType::serialize(&buffer[start], Size(buffer.size() - start));
+        BasicType::serialize(&buffer[start + sizeof(Size)], count);
+    }
+};
+
+/// @brief This class deserializes any of the supported types from a buffer in the flat format. The
+/// members a table holds beyond those of the class, written by a newer version of it, are skipped.
+struct FlatDeserializer : DeserializerBase<FlatDeserializer>, DeserializerOps<FlatDeserializer>, FlatLayout
+{
+    using Base = DeserializerBase<FlatDeserializer>;
+    using Ops = DeserializerOps<FlatDeserializer>;
+    using Base::Base;
+    using Ops::operator>>;
+    using Base::operator>>;
+    using Ops::get;
+    using Ops::skip;
+    using Base::skip;
+
+    template <typename T>
+    void readTable(T& value)
+    {
+        Size start = progress(), size = 0, count = 0;
+        *this >> size >> count;
+        SERIO_ASSERT(size >= 2 * sizeof(Size) && count <= (size - 2 * sizeof(Size)) / sizeof(Size) &&
+                         count >= MemberCount<MembersOf<T>>::value,
+                     "Flat table doesn't match the registered members");
+        skip(count * sizeof(Size));
+        CustomClass<T>().deserialize(value, *this);
+        SERIO_ASSERT(progress() - start <= size, "Flat table doesn't match the registered members");
+        skip(size - (progress() - start));
+    }
+};
+
+/// @brief This class deserializes fixed-size values from memory whose length was already checked.
+template <typename E = FixedEncoding>
+struct BasicUncheckedDeserializer : UncheckedDeserializerBase<BasicUncheckedDeserializer<E>, E>,
+                                    DeserializerOps<BasicUncheckedDeserializer<E>>
+{
+    using Base = UncheckedDeserializerBase<BasicUncheckedDeserializer<E>, E>;
+    using Ops = DeserializerOps<BasicUncheckedDeserializer<E>>;
+    using Base::Base;
+    using Ops::operator>>;
+    using Base::operator>>;
+    using Ops::get;
+    using Ops::skip;
+    using Base::skip;
+};
+
+using UncheckedDeserializer = BasicUncheckedDeserializer<>;
+
+/// @brief This class serializes any of the supported types to the sink adapted by `Sink`.
+template <typename Sink, typename E = FixedEncoding>
+struct BasicBufferedSerializer : StreamSerializerBase<BasicBufferedSerializer<Sink, E>, Sink, E>,
+                                 SerializerOps<BasicBufferedSerializer<Sink, E>>
 {
-    using Base = StreamSerializerBase<StreamSerializer>;
-    using Ops = SerializerOps<StreamSerializer>;
+    using Base = StreamSerializerBase<BasicBufferedSerializer<Sink, E>, Sink, E>;
+    using Ops = SerializerOps<BasicBufferedSerializer<Sink, E>>;
     using Base::Base;
     using Ops::operator<<;
     using Base::operator<<;
 };
 
-/// @brief This class deserializes any of the supported types from stream.
-struct StreamDeserializer : StreamDeserializerBase<StreamDeserializer>, DeserializerOps<StreamDeserializer>
+/// @brief This class serializes any of the supported types to stream.
+template <typename E = FixedEncoding>
+using BasicStreamSerializer = BasicBufferedSerializer<StreamSink, E>;
+
+using StreamSerializer = BasicStreamSerializer<>;
+
+/// @brief This class deserializes any of the supported types from the source adapted by `Source`.
+template <typename Source, typename E = FixedEncoding>
+struct BasicBufferedDeserializer : StreamDeserializerBase<BasicBufferedDeserializer<Source, E>, Source, E>,
+                                   DeserializerOps<BasicBufferedDeserializer<Source, E>>
 {
-    using Base = StreamDeserializerBase<StreamDeserializer>;
-    using Ops = DeserializerOps<StreamDeserializer>;
+    using Base = StreamDeserializerBase<BasicBufferedDeserializer<Source, E>, Source, E>;
+    using Ops = DeserializerOps<BasicBufferedDeserializer<Source, E>>;
     using Base::Base;
     using Ops::operator>>;
     using Base::operator>>;
     using Ops::get;
+    using Ops::skip;
+    using Base::skip;
 };
+
+/// @brief This class deserializes any of the supported types from stream.
+template <typename E = FixedEncoding>
+using BasicStreamDeserializer = BasicBufferedDeserializer<StreamSource, E>;
+
+using StreamDeserializer = BasicStreamDeserializer<>;
+
+#ifdef SERIO_UNIX
+/// @brief This class serializes any of the supported types to a POSIX file descriptor.
+template <typename E = FixedEncoding>
+using BasicFdSerializer = BasicBufferedSerializer<FdSink, E>;
+
+using FdSerializer = BasicFdSerializer<>;
+
+/// @brief This class deserializes any of the supported types from a POSIX file descriptor.
+template <typename E = FixedEncoding>
+using BasicFdDeserializer = BasicBufferedDeserializer<FdSource, E>;
+
+using FdDeserializer = BasicFdDeserializer<>;
+#endif
+
+template <typename E, typename It>
+void writeUnchecked(char* ptr, It it, Size count)
+{
+    BasicUncheckedSerializer<E> serializer(ptr);
+    for (; count > 0; --count, ++it) serializer << *it;
+}
+
+template <typename E, typename It>
+void readUnchecked(const char* ptr, It it, Size count)
+{
+    BasicUncheckedDeserializer<E> deserializer(ptr);
+    for (; count > 0; --count, ++it) deserializer >> *it;
+}
+
+template <typename Derived, typename T>
+void readIndexed(const char* data, Size size, Size maxLength, T* values, Size count)
+{
+    using Reader = typename std::conditional<std::is_base_of<FlatLayout, Derived>::value, FlatDeserializer,
+                                             BasicDeserializer<typename Derived::Encoding>>::type;
+    Reader deserializer(data, size, maxLength, true);
+    for (; count > 0; --count, ++values) deserializer >> *values;
+}
 }  // namespace Impl
 }  // namespace Serio
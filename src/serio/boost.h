@@ -237,27 +237,27 @@ struct FusionMap<0>
 };
 
 template <typename T, typename... Ts>
-struct IsContinuous<boost::container::basic_string<T, Ts...>> : std::is_arithmetic<T>
+struct IsContinuous<boost::container::basic_string<T, Ts...>> : IsBulk<T>
 {
 };
 template <typename T, typename... Ts>
-struct IsContinuous<boost::container::vector<T, Ts...>> : std::is_arithmetic<T>
+struct IsContinuous<boost::container::vector<T, Ts...>> : IsBulk<T>
 {
 };
 template <typename T, size_t N, typename... Ts>
-struct IsContinuous<boost::container::static_vector<T, N, Ts...>> : std::is_arithmetic<T>
+struct IsContinuous<boost::container::static_vector<T, N, Ts...>> : IsBulk<T>
 {
 };
 template <typename T, size_t N, typename... Ts>
-struct IsContinuous<boost::container::small_vector<T, N, Ts...>> : std::is_arithmetic<T>
+struct IsContinuous<boost::container::small_vector<T, N, Ts...>> : IsBulk<T>
 {
 };
 template <typename T, typename... Ts>
-struct IsContinuous<boost::container::devector<T, Ts...>> : std::is_arithmetic<T>
+struct IsContinuous<boost::container::devector<T, Ts...>> : IsBulk<T>
 {
 };
 template <typename T, size_t N>
-struct IsContinuous<boost::array<T, N>> : std::is_arithmetic<T>
+struct IsContinuous<boost::array<T, N>> : IsBulk<T>
 {
 };
 
@@ -267,7 +267,7 @@ struct IsFixed<boost::array<T, N>> : std::true_type
     static constexpr size_t size() { return N; }
 };
 template <typename T, size_t N>
-struct IsFixedContinuous<boost::array<T, N>> : std::is_arithmetic<T>
+struct IsFixedContinuous<boost::array<T, N>> : IsBulk<T>
 {
 };
 
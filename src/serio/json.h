@@ -180,6 +180,11 @@ class JsonSerializer : public Base::Serializer, public Base::JSON
         return serialize(value.load());
     }
     template <typename T>
+    Value serialize(const Indexed<T>& value)
+    {
+        return serialize(value.value);
+    }
+    template <typename T>
     Value serialize(const BinaryString<T>& value)
     {
         return serializeBinary(value.value.data(), value.value.size());
@@ -549,6 +554,11 @@ class JsonDeserializer : public Base::Deserializer, public Base::JSON
         value.store(iget<T>(item));
     }
     template <typename T>
+    void deserialize(Value& item, Indexed<T> value)
+    {
+        deserialize(item, value.value);
+    }
+    template <typename T>
     void deserialize(Value& item, BinaryString<T> value)
     {
         auto input = item.GetString();
@@ -715,6 +725,34 @@ public:
         return *this;
     }
 
+    template <typename T>
+    Derived& operator>>(Indexed<T> value)
+    {
+        if (stage == Stage::Value)
+            deserialize(json, value);
+        else if (stage == Stage::Array)
+        {
+            SERIO_ASSERT(index < json.Size(), "Request more items from a finished json deserializer");
+            deserialize(json[index++], value);
+        }
+        SERIO_ASSERT(stage != Stage::Object, "Object reading mode of deserializer only supports NVP deserialization");
+
+        return *this;
+    }
+
+    template <typename T>
+    Derived& operator>>(Skip<T>)
+    {
+        if (stage == Stage::Array)
+        {
+            SERIO_ASSERT(index < json.Size(), "Request more items from a finished json deserializer");
+            ++index;
+        }
+        SERIO_ASSERT(stage != Stage::Object, "Object reading mode of deserializer only supports NVP deserialization");
+
+        return *this;
+    }
+
     template <typename T, Size N>
     Derived& operator>>(StaticArrayView<T, N> value)
     {
@@ -33,6 +33,10 @@
 #include <serio/json.h>
 #include <serio/xml.h>
 
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+
 namespace Serio
 {
 /// Selects the serialization backend. Passed as a compile-time template argument to every public
@@ -46,11 +50,14 @@ namespace Serio
 ///   `NVP` is used.
 /// - `XML` produces UTF-8 XML text with the same structural mapping as JSON. Prefer JSON unless
 ///   an XML consumer is on the other end.
+/// - `Flat` is the binary format with registered classes laid out as tables of member offsets, so
+///   `FlatView` can read single members in place without decoding the rest. Requires C++14.
 enum Type
 {
     Binary,
     JSON,
     XML,
+    Flat,
 };
 
 /// Options that control how data is serialized. Pass a default-constructed instance when none of
@@ -82,6 +89,62 @@ struct SerializeOptions
     /// same password must be supplied in `DeserializeOptions::decryptPassword` to recover the
     /// data. Not supported in streaming mode.
     std::string encryptPassword;
+
+    /// When true, binary output is measured with `serializedSize()` before it is written, so the
+    /// output buffer is allocated once at its final size instead of growing while the payload is
+    /// produced. The measuring pass walks the values a second time but writes nothing, and it is
+    /// O(1) for continuous arithmetic containers; it pays off for large payloads, where growing a
+    /// buffer means repeated reallocation and copying. Has no effect on JSON or XML output.
+    bool presize = false;
+
+    /// When true, binary output writes container sizes and integers wider than one byte as LEB128
+    /// varints, with ZigZag mapping for signed types, instead of at their full width. Payloads of
+    /// short strings, small containers and small numbers shrink considerably, at the cost of
+    /// element-by-element encoding for integer arrays. The choice is recorded in the header, so
+    /// deserialization needs no matching option. Has no effect on JSON or XML output.
+    bool varint = false;
+
+    /// When true, binary output stores numbers wider than one byte in big-endian byte order instead
+    /// of the default little-endian order, for exchange with systems that expect it. On
+    /// little-endian hosts, contiguous arithmetic containers are then byte-swapped in blocks rather
+    /// than copied. The choice is recorded in the header, so deserialization needs no matching
+    /// option. Has no effect on JSON or XML output.
+    bool bigEndian = false;
+
+    /// Size in bytes of the buffer that binary `write()` collects small values in before handing
+    /// them to the stream in one block. Larger buffers mean fewer stream calls; blocks at least
+    /// this large, such as big arithmetic arrays, are passed to the stream directly. Has no effect
+    /// on the other functions or on JSON or XML output.
+    Size streamBuffer = Size(1) << 16;
+
+    /// When true, `save()` opens the file with `O_DIRECT`, so the data goes from the aligned
+    /// buffer of the serializer to the disk without passing through the page cache. Useful for
+    /// large snapshots that won't be read again soon. Only available on platforms that have
+    /// `O_DIRECT`; ignored elsewhere. To write to a descriptor in this mode, open it with
+    /// `O_DIRECT` and pass it to `write()`.
+    bool directIO = false;
+
+    /// When true, `save()` and `write()` to a file descriptor flush the data to stable storage with
+    /// `fdatasync` before returning, so it survives a crash once they return. Has no effect on the
+    /// other functions.
+    bool syncFile = false;
+
+    /// When true, binary `save()` serializes straight into a shared memory mapping of the file
+    /// instead of building the output in a string first, so peak memory no longer includes a copy
+    /// of the whole payload. The file grows in large steps while it is written and is cut to its
+    /// final size at the end; with `presize` it is sized exactly up front. Compressed or encrypted
+    /// output still needs the full payload and is saved the usual way. Only available on Unix-like
+    /// platforms; ignored elsewhere and for JSON and XML output.
+    bool mapFile = false;
+
+    /// When true, binary output writes an object owned by `std::shared_ptr` (or reached through a
+    /// `std::weak_ptr`) once, the first time it is met, and later pointers to the same object as a
+    /// small reference to it. Graphs whose nodes are shared shrink accordingly and come back with
+    /// the sharing intact, and cycles of pointers, which otherwise recurse forever, can be written.
+    /// The choice is recorded in the header, so deserialization needs no matching option. Can't be
+    /// combined with `Serio::indexed()` or with the `Flat` format. Has no effect on JSON or XML
+    /// output.
+    bool trackPointers = false;
 };
 
 /// Options that control how data is deserialized. Pass a default-constructed instance when none
@@ -100,6 +163,92 @@ struct DeserializeOptions
     /// an exception depending on the underlying crypto library. Leave empty (the default) when
     /// the data is not encrypted.
     std::string decryptPassword;
+
+    /// Size in bytes of the window binary `read()` fills from the stream and decodes small values
+    /// from. The window is only filled with what the stream can deliver without blocking, and
+    /// bytes read past the last value are given back to the stream afterwards. Has no effect on
+    /// the other functions or on JSON or XML input.
+    Size streamBuffer = Size(1) << 18;
+
+    /// Number of `streamBuffer`-sized blocks that binary `read()` and `load()` read ahead on a
+    /// helper thread, so that disk or network time overlaps with decoding instead of adding to
+    /// it. Zero (the default) disables the helper thread; otherwise at least two blocks are used.
+    /// The stream is read to its end, and bytes past the last value are only given back to
+    /// streams that can seek. `load()` reads the file this way instead of mapping it, unless the
+    /// data is compressed, encrypted or checksummed.
+    Size prefetch = 0;
+
+    /// When true, `load()` advises the kernel that its file mapping is read from front to back, so
+    /// it reads ahead aggressively. Like the other `map` options below, it only applies on
+    /// Unix-like platforms when the file is mapped, and hints the platform lacks are ignored.
+    bool mapSequential = false;
+
+    /// When true, `load()` asks the kernel to start reading the whole file into memory before
+    /// decoding begins, with `readahead()` and `MADV_WILLNEED`.
+    bool mapWillNeed = false;
+
+    /// When true, `load()` maps the file with `MAP_POPULATE`, so every page is read in up front
+    /// instead of faulting in one at a time while decoding.
+    bool mapPopulate = false;
+
+    /// When true, `load()` asks for the file mapping to be backed by transparent huge pages, which
+    /// cuts page-table and TLB overhead on very large files where the kernel supports it.
+    bool mapHugePages = false;
+
+    /// When non-zero, binary `load()` drops the pages of the file mapping that decoding has moved
+    /// past, each time this many bytes of them have piled up, from both the process and the page
+    /// cache. Snapshots larger than memory then no longer stay resident after use. Has no effect
+    /// when the file is compressed or encrypted, since the payload is decoded from a copy then.
+    Size mapRelease = 0;
+
+    /// When true, binary deserialization binds `std::basic_string_view`, `std::span` and
+    /// `PointerView` values of const elements straight to the bytes inside the input instead of
+    /// copying them out. The views are only valid while the input stays alive and unchanged, so
+    /// keep the buffer, or the `FileMapping` of a file, around for as long as they are used. Binding
+    /// needs elements stored as they are in memory, in native byte order, and suitably aligned;
+    /// otherwise, or when the data is compressed or encrypted, `Serio::Exception` is thrown. Views
+    /// can't be deserialized at all when this is false, or by `read()` and `load()`.
+    bool zeroCopy = false;
+
+    /// When true, binary deserialization recycles what the target values already hold, for loops
+    /// that decode message after message into the same object. Nodes of maps and sets are taken out
+    /// and read into again (from C++17), `std::unique_ptr`s of non-polymorphic types and engaged
+    /// optionals are read into in place. Vectors and strings always keep their capacity and
+    /// elements. Values of classes must then be fully overwritten by their `_deserialize`. Has no
+    /// effect on JSON or XML input.
+    bool reuse = false;
+
+    /// When set, binary deserialization takes the memory of what it creates from this
+    /// `std::pmr::memory_resource` (C++17), such as a `std::pmr::monotonic_buffer_resource` that is
+    /// released at once when a request is done. `std::pmr` containers and strings made while
+    /// decoding, like map keys, set elements and the values of optionals, are created on it, and so
+    /// are the pointees of `std::shared_ptr`s. Containers the target already holds keep their own
+    /// allocator, so construct them on the resource as well. The resource has to outlive everything
+    /// decoded from it. Has no effect on JSON or XML input.
+    MemoryResource* memoryResource = nullptr;
+
+    /// When true, binary `deserialize()` and `load()` read the payload without checking lengths and
+    /// bounds against the input, which removes a branch per value from decoding. Only set it for
+    /// input known to be well-formed: input that passed `Serio::validate()`, that was written by a
+    /// trusted peer, or that was read back from local storage under a checksum. Malformed input is
+    /// then read out of bounds instead of throwing `Serio::Exception`, and `maxLength` isn't
+    /// enforced. The header, checksum and ids of variants and derived classes are still checked.
+    /// Has no effect on `read()`, on `load()` with `mapRelease`, or on the other formats.
+    bool trusted = false;
+};
+
+/// Outcome of `serializeInto()` when the destination has a fixed capacity. Converts to `true` when
+/// the output was written.
+struct SerializeResult
+{
+    /// The number of bytes written on success. When the destination was too small, the number of
+    /// bytes it must be able to hold instead.
+    Size size;
+
+    /// False when the destination was too small. Nothing is written in that case.
+    bool written;
+
+    explicit operator bool() const { return written; }
 };
 
 namespace Impl
@@ -112,12 +261,35 @@ struct Flags
         Checksum = 0b00000001,
         Compress = 0b00000010,
         Encrypt = 0b00000100,
+        Varint = 0b00001000,
+        BigEndian = 0b00010000,
+        Flat = 0b00100000,
+        Tracked = 0b01000000,
     };
 };
 
-inline void writeHeader(char* data, bool checksum, bool compress, bool encrypt, uint32_t crc)
+/// The header flags that record the encoding policy `E`.
+template <typename E>
+uint8_t encodingFlags()
 {
     uint8_t flags = Flags::None;
+    if (E::Variable::value) flags |= Flags::Varint;
+    if (E::Order::value == ByteOrder::Big) flags |= Flags::BigEndian;
+    return flags;
+}
+
+/// The header flags that record the encoding policy `E` and the choices of `options` that readers
+/// must follow.
+template <typename E>
+uint8_t encodingFlags(const SerializeOptions& options)
+{
+    return uint8_t(encodingFlags<E>() | (options.trackPointers ? Flags::Tracked : Flags::None));
+}
+
+inline void writeHeader(char* data, bool checksum, bool compress, bool encrypt, uint32_t crc,
+                        uint8_t encoding = Flags::None)
+{
+    uint8_t flags = encoding;
     if (checksum) flags |= Flags::Checksum;
     if (compress) flags |= Flags::Compress;
     if (encrypt) flags |= Flags::Encrypt;
@@ -131,12 +303,12 @@ inline void writeHeader(char* data, bool checksum, bool compress, bool encrypt,
     BasicType::serialize(data + 4, crc);
 }
 
-inline void writeHeader(std::ostream& stream)
+inline void writeHeader(std::ostream& stream, uint8_t encoding = Flags::None)
 {
     char data[4];
     data[0] = SERIO_VERSION_MAJOR;
     data[1] = SERIO_VERSION_MINOR;
-    data[2] = 0;
+    data[2] = encoding;
     data[3] = 0;
     stream.write(data, 4);
 }
@@ -151,7 +323,7 @@ inline void readHeader(StringView data, uint8_t& flags, Size& header)
 
     SERIO_ASSERT(major == SERIO_VERSION_MAJOR, "Major version mismatch");
     SERIO_ASSERT(minor <= SERIO_VERSION_MINOR, "Minor version mismatch");
-    SERIO_ASSERT((flags & 0b11111000) == 0, "Invalid flags in header");
+    SERIO_ASSERT((flags & 0b10000000) == 0, "Invalid flags in header");
     SERIO_ASSERT(data[3] == 0, "Invalid data at position 3 in header");
 
     if (flags & Flags::Checksum)
@@ -176,48 +348,254 @@ inline void readHeader(std::istream& stream, uint8_t& flags)
 
     SERIO_ASSERT(major == SERIO_VERSION_MAJOR, "Major version mismatch");
     SERIO_ASSERT(minor <= SERIO_VERSION_MINOR, "Minor version mismatch");
-    SERIO_ASSERT(flags == 0, "Invalid flags in header");
+    SERIO_ASSERT((flags & 0b10000000) == 0, "Invalid flags in header");
     SERIO_ASSERT(data[3] == 0, "Invalid data at position 3 in header");
 }
 
-template <Type T, typename... Ts>
-EnableIfT<T == Type::Binary, std::string> serialize(const SerializeOptions& options, Ts&&... ts)
+template <typename E, typename... Ts>
+std::string serializeBinary(const SerializeOptions& options, Ts&&... ts)
 {
     bool checksum = options.enableChecksum;
     bool compress = options.compressLevel > -1;
     bool encrypt = !options.encryptPassword.empty();
 
+    Buffer payload;
     std::string data, buffer;
     Size headerSize = 4 + (checksum ? 4 : 0);
 
+    if (options.presize)
+    {
+        Size size = Impl::BasicSizeSerializer<E>().tracking(options.trackPointers).process(ts...).size();
+        if (compress || encrypt)
+            payload.reserve(size);
+        else
+            data.reserve(headerSize + size);
+    }
+
     if (compress && !encrypt)
     {
-        Impl::Serializer(buffer).process(std::forward<Ts>(ts)...);
-        Impl::compress(buffer, data, options.compressLevel, headerSize);
+        Impl::BufferSerializer<std::allocator<char>, E>(payload)
+            .tracking(options.trackPointers)
+            .process(std::forward<Ts>(ts)...);
+        Impl::compress(payload.view(), data, options.compressLevel, headerSize);
     }
     else if (!compress && encrypt)
     {
-        Impl::Serializer(buffer).process(std::forward<Ts>(ts)...);
-        Impl::encrypt(buffer, data, options.encryptPassword, headerSize);
+        Impl::BufferSerializer<std::allocator<char>, E>(payload)
+            .tracking(options.trackPointers)
+            .process(std::forward<Ts>(ts)...);
+        Impl::encrypt(payload.view(), data, options.encryptPassword, headerSize);
     }
     else if (compress && encrypt)
     {
-        Impl::Serializer(data).process(std::forward<Ts>(ts)...);
-        Impl::compress(data, buffer, options.compressLevel, 0);
+        Impl::BufferSerializer<std::allocator<char>, E>(payload)
+            .tracking(options.trackPointers)
+            .process(std::forward<Ts>(ts)...);
+        Impl::compress(payload.view(), buffer, options.compressLevel, 0);
         Impl::encrypt(buffer, data, options.encryptPassword, headerSize);
     }
     else
     {
         data.resize(headerSize);
-        Impl::Serializer(data).process(std::forward<Ts>(ts)...);
+        Impl::BasicSerializer<StringOutput, E>(data).tracking(options.trackPointers).process(std::forward<Ts>(ts)...);
     }
 
     uint32_t crc = 0;
     if (checksum) crc = Impl::crcCreate(StringView(data).view(headerSize));
-    Impl::writeHeader(&data.front(), checksum, compress, encrypt, crc);
+    Impl::writeHeader(&data.front(), checksum, compress, encrypt, crc, encodingFlags<E>(options));
     return data;
 }
 
+template <typename E, typename... Ts>
+Size binarySize(const SerializeOptions& options, const Ts&... ts)
+{
+    Size header = 4 + (options.enableChecksum ? 4 : 0);
+    return header + Impl::BasicSizeSerializer<E>().tracking(options.trackPointers).process(ts...).size();
+}
+
+// Writes header and payload to memory that is known to hold the `size` bytes `binarySize()` returned.
+// A custom `serialize()` that writes other than what it measured is caught, though only afterwards.
+template <typename E, typename... Ts>
+void serializeBinaryTo(const SerializeOptions& options, char* data, Size size, Ts&&... ts)
+{
+    bool checksum = options.enableChecksum;
+    Size headerSize = 4 + (checksum ? 4 : 0);
+
+    char* ptr = data + headerSize;
+    Impl::BasicSerializer<PointerOutput, E>(ptr).tracking(options.trackPointers).process(std::forward<Ts>(ts)...);
+    SERIO_ASSERT(Size(ptr - data) == size, "Serialized size doesn't match the size measured for it");
+
+    uint32_t crc = 0;
+    if (checksum) crc = Impl::crcCreate(StringView(data + headerSize, Size(ptr - data) - headerSize));
+    Impl::writeHeader(data, checksum, false, false, crc, encodingFlags<E>(options));
+}
+
+template <typename E, typename... Ts>
+SerializeResult serializeInto(const SerializeOptions& options, char* data, Size capacity, Ts&&... ts)
+{
+    if (options.compressLevel > -1 || !options.encryptPassword.empty())
+    {
+        auto bytes = serializeBinary<E>(options, std::forward<Ts>(ts)...);
+        if (bytes.size() > capacity) return {bytes.size(), false};
+        std::memcpy(data, bytes.data(), bytes.size());
+        return {bytes.size(), true};
+    }
+
+    Size size = binarySize<E>(options, ts...);
+    if (size > capacity) return {size, false};
+    serializeBinaryTo<E>(options, data, size, std::forward<Ts>(ts)...);
+    return {size, true};
+}
+
+// Appends to any contiguous container of bytes with `size()`, `resize()` and `data()`.
+template <typename E, typename Container, typename... Ts>
+Size serializeAppend(const SerializeOptions& options, Container& container, Ts&&... ts)
+{
+    Size offset = container.size();
+    if (options.compressLevel > -1 || !options.encryptPassword.empty())
+    {
+        auto bytes = serializeBinary<E>(options, std::forward<Ts>(ts)...);
+        container.resize(offset + bytes.size());
+        std::memcpy((char*)container.data() + offset, bytes.data(), bytes.size());
+        return bytes.size();
+    }
+
+    Size size = binarySize<E>(options, ts...);
+    container.resize(offset + size);
+    serializeBinaryTo<E>(options, (char*)container.data() + offset, size, std::forward<Ts>(ts)...);
+    return size;
+}
+
+template <typename E, typename... Ts>
+Size serializeSegments(const SerializeOptions& options, Segments& segments, Ts&&... ts)
+{
+    Size start = segments.size();
+    if (options.compressLevel > -1 || !options.encryptPassword.empty())
+    {
+        auto bytes = serializeBinary<E>(options, std::forward<Ts>(ts)...);
+        std::memcpy(segments.take(bytes.size()), bytes.data(), bytes.size());
+        return bytes.size();
+    }
+
+    bool checksum = options.enableChecksum;
+    Size headerSize = 4 + (checksum ? 4 : 0);
+    Size header = segments.staging().size();
+    segments.take(headerSize);
+    Impl::SegmentSerializer<E>(segments).tracking(options.trackPointers).process(std::forward<Ts>(ts)...);
+
+    uint32_t crc = 0;
+    if (checksum) crc = Impl::crcCreate(segments, start + headerSize);
+    Impl::writeHeader(segments.staging().data() + header, checksum, false, false, crc, encodingFlags<E>(options));
+    return segments.size() - start;
+}
+
+template <typename E, typename... Ts>
+Size deserializeBinary(const DeserializeOptions& options, bool tracked, const char* data, Size size, Ts&&... ts)
+{
+    if (options.trusted)
+        return Impl::BasicTrustedDeserializer<E>(data, size, options.maxLength, options.zeroCopy, options.reuse,
+                                                 options.memoryResource)
+            .tracking(tracked)
+            .process(std::forward<Ts>(ts)...)
+            .progress();
+    return Impl::BasicDeserializer<E>(data, size, options.maxLength, options.zeroCopy, options.reuse,
+                                      options.memoryResource)
+        .tracking(tracked)
+        .process(std::forward<Ts>(ts)...)
+        .progress();
+}
+
+#ifdef SERIO_UNIX
+template <typename E, typename... Ts>
+Size deserializeBinary(const DeserializeOptions& options, bool tracked, MappedFile& file, const char* data, Size size,
+                       Ts&&... ts)
+{
+    return Impl::BasicMappedDeserializer<E>(file, data, size, options.maxLength, options.reuse, options.memoryResource)
+        .tracking(tracked)
+        .process(std::forward<Ts>(ts)...)
+        .progress();
+}
+#endif
+
+// Deserializes with the encoding and tracking recorded in the header `flags`; `args` are the
+// arguments of `deserializeBinary<E>()` after the options and tracking.
+template <typename... Ts>
+Size deserializeBinary(uint8_t flags, const DeserializeOptions& options, Ts&&... args)
+{
+    SERIO_ASSERT(!(flags & Flags::Flat), "Flat data can only be read as Type::Flat");
+    bool big = flags & Flags::BigEndian, tracked = flags & Flags::Tracked;
+    if (flags & Flags::Varint)
+        return big ? deserializeBinary<BigVarintEncoding>(options, tracked, std::forward<Ts>(args)...)
+                   : deserializeBinary<VarintEncoding>(options, tracked, std::forward<Ts>(args)...);
+    return big ? deserializeBinary<BigFixedEncoding>(options, tracked, std::forward<Ts>(args)...)
+               : deserializeBinary<FixedEncoding>(options, tracked, std::forward<Ts>(args)...);
+}
+
+template <typename E, typename... Ts>
+void writeBinary(const SerializeOptions& options, std::ostream& stream, Ts&&... ts)
+{
+    Impl::writeHeader(stream, encodingFlags<E>(options));
+    Impl::BasicStreamSerializer<E>(stream, options.streamBuffer)
+        .tracking(options.trackPointers)
+        .process(std::forward<Ts>(ts)...)
+        .flush();
+}
+
+template <typename E, typename... Ts>
+void readBinary(const DeserializeOptions& options, bool tracked, std::istream& stream, Ts&&... ts)
+{
+    Impl::BasicStreamDeserializer<E>(stream, options.maxLength, options.streamBuffer, options.reuse,
+                                     options.memoryResource)
+        .tracking(tracked)
+        .process(std::forward<Ts>(ts)...);
+}
+
+#ifdef SERIO_UNIX
+template <typename E, typename... Ts>
+void writeBinary(const SerializeOptions& options, int fd, Ts&&... ts)
+{
+    if (options.presize) preallocateFile(fd, binarySize<E>(options, ts...));
+    char header[4];
+    Impl::writeHeader(header, false, false, false, 0, encodingFlags<E>(options));
+    Impl::BasicFdSerializer<E> serializer(fd, options.streamBuffer);
+    serializer.write(header, 4);
+    serializer.tracking(options.trackPointers).process(std::forward<Ts>(ts)...).flush();
+}
+
+template <typename E, typename... Ts>
+void readBinary(const DeserializeOptions& options, bool tracked, int fd, Ts&&... ts)
+{
+    Impl::BasicFdDeserializer<E>(fd, options.maxLength, options.streamBuffer, options.reuse, options.memoryResource)
+        .tracking(tracked)
+        .process(std::forward<Ts>(ts)...);
+}
+#endif
+
+template <typename Input, typename... Ts>
+void readBinary(uint8_t flags, const DeserializeOptions& options, Input& input, Ts&&... ts)
+{
+    SERIO_ASSERT(!(flags & Flags::Flat), "Flat data can only be read as Type::Flat");
+    bool varint = flags & Flags::Varint, big = flags & Flags::BigEndian, tracked = flags & Flags::Tracked;
+    if (varint && big)
+        readBinary<BigVarintEncoding>(options, tracked, input, std::forward<Ts>(ts)...);
+    else if (varint)
+        readBinary<VarintEncoding>(options, tracked, input, std::forward<Ts>(ts)...);
+    else if (big)
+        readBinary<BigFixedEncoding>(options, tracked, input, std::forward<Ts>(ts)...);
+    else
+        readBinary<FixedEncoding>(options, tracked, input, std::forward<Ts>(ts)...);
+}
+
+template <Type T, typename... Ts>
+EnableIfT<T == Type::Binary, std::string> serialize(const SerializeOptions& options, Ts&&... ts)
+{
+    if (options.varint)
+        return options.bigEndian ? serializeBinary<BigVarintEncoding>(options, std::forward<Ts>(ts)...)
+                                 : serializeBinary<VarintEncoding>(options, std::forward<Ts>(ts)...);
+    return options.bigEndian ? serializeBinary<BigFixedEncoding>(options, std::forward<Ts>(ts)...)
+                             : serializeBinary<FixedEncoding>(options, std::forward<Ts>(ts)...);
+}
+
 template <Type T, typename... Ts>
 EnableIfT<T == Type::JSON, std::string> serialize(const SerializeOptions& options, Ts&&... ts)
 {
@@ -236,6 +614,60 @@ EnableIfT<T == Type::XML, std::string> serialize(const SerializeOptions& options
         .finalize(options.compactFrom);
 }
 
+#if SERIO_CPP_VERSION >= 201402L
+template <Type T, typename... Ts>
+EnableIfT<T == Type::Flat, std::string> serialize(const SerializeOptions& options, Ts&&... ts)
+{
+    SERIO_ASSERT(!options.varint && !options.bigEndian, "Flat data is always fixed-width little-endian");
+    SERIO_ASSERT(!options.trackPointers, "Flat data can't be written with pointer tracking");
+    SERIO_ASSERT(options.compressLevel < 0 && options.encryptPassword.empty(),
+                 "Flat data is read in place, so it can't be compressed or encrypted");
+    bool checksum = options.enableChecksum;
+    Size headerSize = 4 + (checksum ? 4 : 0);
+
+    std::string data(headerSize, 0);
+    Impl::FlatSerializer(data).process(std::forward<Ts>(ts)...);
+    uint32_t crc = 0;
+    if (checksum) crc = Impl::crcCreate(StringView(data).view(headerSize));
+    Impl::writeHeader(&data.front(), checksum, false, false, crc, Flags::Flat);
+    return data;
+}
+
+// Checks the header of flat `data` and returns its size.
+inline Size readFlatHeader(StringView data)
+{
+    uint8_t flags;
+    Size header = 0;
+    Impl::readHeader(data, flags, header);
+    SERIO_ASSERT(flags & Flags::Flat, "Data is not in the flat format");
+    return header;
+}
+
+template <Type T, typename... Ts>
+EnableIfT<T == Type::Flat, Size> deserialize(const DeserializeOptions& options, StringView data, Ts&&... ts)
+{
+    Size header = readFlatHeader(data);
+    return Impl::FlatDeserializer(data.data + header, data.size - header, options.maxLength, options.zeroCopy,
+                                  options.reuse, options.memoryResource)
+        .process(std::forward<Ts>(ts)...)
+        .progress();
+}
+
+template <Type T, typename... Ts>
+EnableIfT<T == Type::Flat, void> write(const SerializeOptions& options, std::ostream& stream, Ts&&... ts)
+{
+    auto data = Impl::serialize<T>(options, std::forward<Ts>(ts)...);
+    stream.write(data.data(), data.size());
+}
+
+template <Type T, typename... Ts>
+EnableIfT<T == Type::Flat, void> read(const DeserializeOptions& options, std::istream& stream, Ts&&... ts)
+{
+    std::string data{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    Impl::deserialize<T>(options, data, std::forward<Ts>(ts)...);
+}
+#endif
+
 template <Type T, typename... Ts>
 EnableIfT<T == Type::Binary, Size> deserialize(const DeserializeOptions& options, StringView data, Ts&&... ts)
 {
@@ -246,6 +678,7 @@ EnableIfT<T == Type::Binary, Size> deserialize(const DeserializeOptions& options
     Impl::readHeader(data, flags, header);
     bool compress = flags & Impl::Flags::Compress;
     bool encrypt = flags & Impl::Flags::Encrypt;
+    SERIO_ASSERT(!options.zeroCopy || !(compress || encrypt), "Zero-copy mode needs uncompressed, unencrypted data");
     auto ptr = data.data + header;
     auto size = data.size - header;
 
@@ -270,7 +703,7 @@ EnableIfT<T == Type::Binary, Size> deserialize(const DeserializeOptions& options
         size = buffer.size();
     }
 
-    return Impl::Deserializer(ptr, size, options.maxLength).process(std::forward<Ts>(ts)...).progress();
+    return deserializeBinary(flags, options, ptr, size, std::forward<Ts>(ts)...);
 }
 
 template <Type T, typename... Ts>
@@ -290,7 +723,14 @@ EnableIfT<T == Type::XML, void> deserialize(const DeserializeOptions& options, S
 template <Type T, typename... Ts>
 EnableIfT<T == Type::Binary, void> write(const SerializeOptions& options, std::ostream& stream, Ts&&... ts)
 {
-    Impl::StreamSerializer(stream).process(std::forward<Ts>(ts)...);
+    if (options.varint && options.bigEndian)
+        writeBinary<BigVarintEncoding>(options, stream, std::forward<Ts>(ts)...);
+    else if (options.varint)
+        writeBinary<VarintEncoding>(options, stream, std::forward<Ts>(ts)...);
+    else if (options.bigEndian)
+        writeBinary<BigFixedEncoding>(options, stream, std::forward<Ts>(ts)...);
+    else
+        writeBinary<FixedEncoding>(options, stream, std::forward<Ts>(ts)...);
 }
 
 template <Type T, typename... Ts>
@@ -310,8 +750,16 @@ EnableIfT<T == Type::XML, void> write(const SerializeOptions& options, std::ostr
 template <Type T, typename... Ts>
 EnableIfT<T == Type::Binary, void> read(const DeserializeOptions& options, std::istream& stream, Ts&&... ts)
 {
-    Impl::StreamDeserializer deserializer(stream, options.maxLength);
-    deserializer.process(std::forward<Ts>(ts)...);
+    uint8_t flags;
+    Impl::readHeader(stream, flags);
+    SERIO_ASSERT(!(flags & Flags::Checksum), "Checksum is not supported in stream mode");
+    SERIO_ASSERT(!(flags & Flags::Compress), "Decompression is not supported in stream mode");
+    SERIO_ASSERT(!(flags & Flags::Encrypt), "Decryption is not supported in stream mode");
+
+    if (options.prefetch == 0) return readBinary(flags, options, stream, std::forward<Ts>(ts)...);
+    PrefetchBuffer buffer(stream.rdbuf(), options.streamBuffer, options.prefetch);
+    std::istream source(&buffer);
+    readBinary(flags, options, source, std::forward<Ts>(ts)...);
 }
 
 template <Type T, typename... Ts>
@@ -328,8 +776,440 @@ EnableIfT<T == Type::XML, void> read(const DeserializeOptions& options, std::ist
     XmlDeserializer::Document document;
     XmlDeserializer::parse(document, stream, buffer).process(std::forward<Ts>(ts)...);
 }
+
+#ifdef SERIO_UNIX
+inline void readHeader(int fd, uint8_t& flags)
+{
+    char data[4];
+    SERIO_ASSERT(FdSource(fd).read(data, 4, 4) == 4, "Data size must be at least 4 bytes");
+    uint8_t major = data[0];
+    uint8_t minor = data[1];
+    flags = data[2];
+
+    SERIO_ASSERT(major == SERIO_VERSION_MAJOR, "Major version mismatch");
+    SERIO_ASSERT(minor <= SERIO_VERSION_MINOR, "Minor version mismatch");
+    SERIO_ASSERT((flags & 0b10000000) == 0, "Invalid flags in header");
+    SERIO_ASSERT(data[3] == 0, "Invalid data at position 3 in header");
+}
+
+template <Type T, typename... Ts>
+EnableIfT<T == Type::Binary, void> write(const SerializeOptions& options, int fd, Ts&&... ts)
+{
+    if (options.varint && options.bigEndian)
+        writeBinary<BigVarintEncoding>(options, fd, std::forward<Ts>(ts)...);
+    else if (options.varint)
+        writeBinary<VarintEncoding>(options, fd, std::forward<Ts>(ts)...);
+    else if (options.bigEndian)
+        writeBinary<BigFixedEncoding>(options, fd, std::forward<Ts>(ts)...);
+    else
+        writeBinary<FixedEncoding>(options, fd, std::forward<Ts>(ts)...);
+}
+
+template <Type T, typename... Ts>
+EnableIfT<T != Type::Binary, void> write(const SerializeOptions& options, int fd, Ts&&... ts)
+{
+    auto data = Impl::serialize<T>(options, std::forward<Ts>(ts)...);
+    FdSink(fd).write(data.data(), data.size(), true);
+}
+
+template <Type T, typename... Ts>
+EnableIfT<T == Type::Binary, void> read(const DeserializeOptions& options, int fd, Ts&&... ts)
+{
+    uint8_t flags;
+    Impl::readHeader(fd, flags);
+    SERIO_ASSERT(!(flags & Flags::Checksum), "Checksum is not supported in stream mode");
+    SERIO_ASSERT(!(flags & Flags::Compress), "Decompression is not supported in stream mode");
+    SERIO_ASSERT(!(flags & Flags::Encrypt), "Decryption is not supported in stream mode");
+    adviseSequential(fd);
+    readBinary(flags, options, fd, std::forward<Ts>(ts)...);
+}
+
+template <Type T, typename... Ts>
+EnableIfT<T != Type::Binary, void> read(const DeserializeOptions& options, int fd, Ts&&... ts)
+{
+    std::string data;
+    FdSource source(fd);
+    for (Size size = 0, count = 1; count > 0; size += count)
+    {
+        data.resize(size + (Size(1) << 16));
+        count = source.read(&data[size], 1, data.size() - size);
+        data.resize(size + count);
+    }
+    Impl::deserialize<T>(options, data, std::forward<Ts>(ts)...);
+}
+
+template <typename E, typename... Ts>
+void saveMapped(const SerializeOptions& options, const std::string& path, Ts&&... ts)
+{
+    MappedFileWriter file;
+    Size size = options.presize ? binarySize<E>(options, ts...) : 0;
+    SERIO_ASSERT(file.open(path, size), "Failed to open file for writing");
+    if (options.presize)
+        serializeBinaryTo<E>(options, file.take(size), size, std::forward<Ts>(ts)...);
+    else
+    {
+        bool checksum = options.enableChecksum;
+        Size headerSize = 4 + (checksum ? 4 : 0);
+        file.take(headerSize);
+        Impl::MappedSerializer<E>(file).tracking(options.trackPointers).process(std::forward<Ts>(ts)...);
+
+        uint32_t crc = 0;
+        if (checksum) crc = Impl::crcCreate(StringView(file.begin() + headerSize, file.size() - headerSize));
+        Impl::writeHeader(file.begin(), checksum, false, false, crc, encodingFlags<E>(options));
+    }
+    SERIO_ASSERT(file.close(options.syncFile), "Failed to write file");
+}
+
+// Saves binary output through a file mapping. Returns false, having written nothing, when
+// `options` ask for output that needs the full payload first.
+template <Type T, typename... Ts>
+EnableIfT<T == Type::Binary, bool> saveMapped(const SerializeOptions& options, const std::string& path, Ts&&... ts)
+{
+    if (options.compressLevel > -1 || !options.encryptPassword.empty()) return false;
+    if (options.varint && options.bigEndian)
+        saveMapped<BigVarintEncoding>(options, path, std::forward<Ts>(ts)...);
+    else if (options.varint)
+        saveMapped<VarintEncoding>(options, path, std::forward<Ts>(ts)...);
+    else if (options.bigEndian)
+        saveMapped<BigFixedEncoding>(options, path, std::forward<Ts>(ts)...);
+    else
+        saveMapped<FixedEncoding>(options, path, std::forward<Ts>(ts)...);
+    return true;
+}
+
+template <Type T, typename... Ts>
+EnableIfT<T != Type::Binary, bool> saveMapped(const SerializeOptions&, const std::string&, Ts&&...)
+{
+    return false;
+}
+
+// Writes `data` to the file at `path` through a file descriptor whose space is reserved up front,
+// with `O_DIRECT` and a final sync when `options` ask for them.
+inline bool writeFile(const SerializeOptions& options, const std::string& path, const std::string& data)
+{
+    struct CloseWrapper
+    {
+        int fd;
+        ~CloseWrapper() { close(fd); }
+    };
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+    if (options.directIO) flags |= O_DIRECT;
+#endif
+    int fd = ::open(path.c_str(), flags, 0666);
+#ifdef O_DIRECT
+    if (fd == -1 && errno == EINVAL && (flags & O_DIRECT)) fd = ::open(path.c_str(), flags & ~O_DIRECT, 0666);
+#endif
+    if (fd == -1) return false;
+    CloseWrapper wrapper{fd};
+
+    preallocateFile(fd, data.size());
+    FdSerializer serializer(fd, options.streamBuffer);
+    serializer.write(data.data(), data.size());
+    serializer.flush();
+    return !options.syncFile || syncFile(fd);
+}
+#endif
+
+#ifdef SERIO_UNIX
+inline MapAdvice mapAdvice(const DeserializeOptions& options)
+{
+    MapAdvice advice;
+    advice.sequential = options.mapSequential;
+    advice.willNeed = options.mapWillNeed;
+    advice.populate = options.mapPopulate;
+    advice.hugePages = options.mapHugePages;
+    advice.release = options.mapRelease;
+    return advice;
+}
+
+// Deserializes the mapped `file`, releasing its pages behind the decoder when `options` ask for it.
+template <Type T, typename... Ts>
+EnableIfT<T == Type::Binary, void> deserializeMapped(const DeserializeOptions& options, MappedFile& file, Ts&&... ts)
+{
+    uint8_t flags;
+    Size header = 0;
+    auto data = file.view();
+    Impl::readHeader(data, flags, header);
+    if (options.mapRelease == 0 || (flags & (Flags::Compress | Flags::Encrypt)))
+        Impl::deserialize<T>(options, data, std::forward<Ts>(ts)...);
+    else
+        deserializeBinary(flags, options, file, data.data + header, data.size - header, std::forward<Ts>(ts)...);
+}
+
+template <Type T, typename... Ts>
+EnableIfT<T != Type::Binary, void> deserializeMapped(const DeserializeOptions& options, MappedFile& file, Ts&&... ts)
+{
+    Impl::deserialize<T>(options, file.view(), std::forward<Ts>(ts)...);
+}
+#endif
+
+// Reads the binary file at `path` through a prefetching stream. Returns false, having read
+// nothing, when the file isn't stored in a form the stream path can decode.
+template <typename... Ts>
+bool loadPrefetched(const DeserializeOptions& options, const std::string& path, Ts&&... ts)
+{
+    std::ifstream stream(path, std::ios::binary);
+    SERIO_ASSERT(stream.is_open(), "Failed to open file for reading");
+    char header[4] = {0, 0, 0, 0};
+    stream.read(header, 4);
+    if (uint8_t(header[2]) & (Flags::Checksum | Flags::Compress | Flags::Encrypt)) return false;
+
+    stream.seekg(0);
+    Impl::read<Type::Binary>(options, stream, std::forward<Ts>(ts)...);
+    return true;
+}
 }  // namespace Impl
 
+#ifdef SERIO_UNIX
+/// A read-only memory mapping of a file that the caller keeps alive. Deserialize from `view()` with
+/// `DeserializeOptions::zeroCopy` to bind string views, spans and `PointerView`s straight to the
+/// file contents instead of copying them; they stay valid for as long as the mapping exists.
+///
+/// The `map` hints of the options passed to the constructor are applied to the mapping, except
+/// for `mapRelease`, which only applies to `load()`.
+class FileMapping
+{
+    std::unique_ptr<Impl::MappedFile> _file;
+
+public:
+    /// Maps the file at `path`. Throws `Serio::Exception` if it cannot be opened or is empty.
+    explicit FileMapping(const std::string& path, const DeserializeOptions& options = {})
+        : _file(new Impl::MappedFile)
+    {
+        auto advice = Impl::mapAdvice(options);
+        advice.release = 0;
+        SERIO_ASSERT(_file->open(path, advice), "Failed to open file for reading");
+    }
+
+    /// The contents of the file.
+    StringView view() const { return _file->view(); }
+};
+#endif
+
+#if SERIO_CPP_VERSION >= 201402L
+template <typename T>
+class FlatView;
+template <typename T>
+class FlatList;
+
+namespace Impl
+{
+// How `FlatView::get()` hands out a member stored in `[data, data + size)`: registered classes and
+// vectors of them as views, and anything else decoded, in place where it is a view type itself.
+template <typename T, class Enable = void>
+struct FlatField
+{
+    using Type = T;
+    static Type get(const char* data, Size size)
+    {
+        T value;
+        FlatDeserializer(data, size, 0, true) >> value;
+        return value;
+    }
+};
+template <typename T>
+struct FlatField<T, EnableIfT<IsRegistered<T>::value>>
+{
+    using Type = FlatView<T>;
+    static Type get(const char* data, Size size) { return Type(data, size); }
+};
+template <typename T, typename... Ts>
+struct FlatField<std::vector<T, Ts...>, EnableIfT<IsRegistered<T>::value>>
+{
+    using Type = FlatList<T>;
+    static Type get(const char* data, Size size) { return Type(data, size); }
+};
+}  // namespace Impl
+
+/// A view of a class `T` registered with `SERIO_REGISTER` inside data in the `Flat` format, made by
+/// `flatView()`. `get<I>()` reads the member at position `I` of the registered list straight from
+/// the buffer, without decoding any other member. Members that are registered classes, or vectors
+/// of them, come back as views themselves, so reaching a value deep inside a message decodes only
+/// that value. Pass a second template argument to `get` to decode a member as another type, such as
+/// `std::string_view` or `std::span<const float>` to read it without copying.
+///
+/// Classes whose members all have a fixed size are stored without a table, and their members are
+/// found at offsets known at compile time. The view points into the buffer, which must outlive it.
+template <typename T>
+class FlatView
+{
+    static_assert(Impl::IsRegistered<T>::value, "Flat views need a class registered with SERIO_REGISTER.");
+
+    using Members = Impl::MembersOf<T>;
+    using Fixed = std::integral_constant<bool, (Impl::WireSize<T>::value > 0)>;
+
+    const char* _data{nullptr};
+    Size _size{0};
+    Size _count{0};
+
+    Size offset(Size index) const
+    {
+        Size value = 0;
+        Impl::BasicType::deserialize(_data + (2 + index) * sizeof(Size), value);
+        return value;
+    }
+    template <Size I>
+    StringView member(std::true_type) const
+    {
+        using M = typename Impl::MemberAt<Members, I>::Type;
+        return StringView(_data + Impl::WireOffset<Members, I>::value, Impl::WireSize<M>::value);
+    }
+    template <Size I>
+    StringView member(std::false_type) const
+    {
+        SERIO_ASSERT(I < _count, "Member is not present in the flat data");
+        Size begin = offset(I), end = I + 1 < _count ? offset(I + 1) : _size;
+        SERIO_ASSERT(begin <= end && end <= _size, "Flat table doesn't match the input buffer");
+        return StringView(_data + begin, end - begin);
+    }
+
+public:
+    /// Constructs an empty view, which must be assigned before it is read.
+    FlatView() = default;
+
+    /// Views the `T` whose flat encoding starts at `data`, in a buffer of `size` more bytes.
+    FlatView(const char* data, Size size) : _data(data)
+    {
+        if (Fixed::value)
+        {
+            SERIO_ASSERT(size >= Impl::WireSize<T>::value, "Requested structure doesn't match the input buffer");
+            _size = Impl::WireSize<T>::value;
+            _count = Impl::MemberCount<Members>::value;
+            return;
+        }
+
+        SERIO_ASSERT(size >= 2 * sizeof(Size), "Requested structure doesn't match the input buffer");
+        Impl::BasicType::deserialize(data, _size);
+        Impl::BasicType::deserialize(data + sizeof(Size), _count);
+        SERIO_ASSERT(_size >= 2 * sizeof(Size) && _size <= size && _count <= (_size - 2 * sizeof(Size)) / sizeof(Size),
+                     "Flat table doesn't match the input buffer");
+    }
+
+    /// Number of members stored. It is lower than the number `T` registers when the data was written
+    /// by an older version of `T` with fewer members, and higher when written by a newer one.
+    Size count() const { return _count; }
+
+    /// True when the member at position `I` is stored.
+    template <Size I>
+    bool has() const
+    {
+        return I < _count;
+    }
+
+    /// Returns the member at position `I`, as a view when it is a registered class or a vector of
+    /// them, and decoded as `V` otherwise. Throws `Serio::Exception` when it is not stored.
+    template <Size I, typename V = typename Impl::MemberAt<Members, I>::Type>
+    typename Impl::FlatField<V>::Type get() const
+    {
+        auto bytes = member<I>(Fixed());
+        return Impl::FlatField<V>::get(bytes.data, bytes.size);
+    }
+
+    /// Decodes the whole value.
+    T decode() const
+    {
+        T value;
+        Impl::FlatDeserializer(_data, _size, 0, true) >> value;
+        return value;
+    }
+
+    /// The bytes the value occupies in the buffer.
+    StringView bytes() const { return StringView(_data, _size); }
+};
+
+/// A view of a `std::vector` of registered class `T` inside flat data, returned by `FlatView::get()`
+/// for such members. Elements of fixed size are found by index directly. Tables are found by
+/// stepping over the ones before them, so iterate rather than index when visiting them all.
+template <typename T>
+class FlatList
+{
+    using Fixed = std::integral_constant<bool, (Impl::WireSize<T>::value > 0)>;
+
+    const char* _data{nullptr};
+    Size _size{0};
+    Size _count{0};
+
+public:
+    /// Forward iterator over the elements, yielding a `FlatView<T>` for each of them.
+    class Iterator
+    {
+        const char* _data;
+        const char* _end;
+        Size _index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatView<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = FlatView<T>;
+
+        Iterator(const char* data, const char* end, Size index) : _data(data), _end(end), _index(index) {}
+
+        FlatView<T> operator*() const { return FlatView<T>(_data, Size(_end - _data)); }
+        Iterator& operator++()
+        {
+            _data += (**this).bytes().size;
+            ++_index;
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+        bool operator==(const Iterator& other) const { return _index == other._index; }
+        bool operator!=(const Iterator& other) const { return _index != other._index; }
+    };
+
+    /// Constructs an empty list.
+    FlatList() = default;
+
+    /// Views the vector whose flat encoding starts at `data`, in a buffer of `size` more bytes.
+    FlatList(const char* data, Size size)
+    {
+        SERIO_ASSERT(size >= sizeof(Size), "Requested structure doesn't match the input buffer");
+        Impl::BasicType::deserialize(data, _count);
+        _data = data + sizeof(Size);
+        _size = size - sizeof(Size);
+        SERIO_ASSERT(!Fixed::value || _count <= _size / std::max<Size>(Impl::WireSize<T>::value, 1),
+                     "Requested structure doesn't match the input buffer");
+    }
+
+    Size size() const { return _count; }
+    bool empty() const { return _count == 0; }
+
+    /// Returns the element at `index`. Throws `Serio::Exception` when it is out of range.
+    FlatView<T> operator[](Size index) const
+    {
+        SERIO_ASSERT(index < _count, "Index is out of range");
+        if (Fixed::value) return FlatView<T>(_data + index * Impl::WireSize<T>::value, Impl::WireSize<T>::value);
+        auto it = begin();
+        for (; index > 0; --index) ++it;
+        return *it;
+    }
+
+    Iterator begin() const { return Iterator(_data, _data + _size, 0); }
+    Iterator end() const { return Iterator(nullptr, nullptr, _count); }
+};
+
+/// Views the first value of `data` produced by `serialize<Type::Flat>()`, a registered class `T`,
+/// without decoding anything. The header is checked, and the checksum if the data has one, which
+/// reads the whole buffer once; the members are then only read when `get` asks for them. Throws
+/// `Serio::Exception` when `data` is not flat data.
+///
+/// `data` can be any buffer that outlives the view, such as the `view()` of a `FileMapping`.
+template <typename T>
+FlatView<T> flatView(StringView data)
+{
+    Size header = Impl::readFlatHeader(data);
+    return FlatView<T>(data.data + header, data.size - header);
+}
+#endif
+
 /// Serializes one or more values into an in-memory `std::string` using the format selected by
 /// `type`. When multiple values are passed they are serialized as an ordered sequence — a flat
 /// byte stream in binary mode, or a JSON/XML array when using those formats.
@@ -342,7 +1222,8 @@ EnableIfT<T == Type::XML, void> read(const DeserializeOptions& options, std::ist
 /// For JSON and XML output, `options.enableChecksum`, `options.compressLevel`, and
 /// `options.encryptPassword` are ignored.
 ///
-/// @tparam type  The serialization format. One of `Type::Binary`, `Type::JSON`, `Type::XML`.
+/// @tparam type  The serialization format. One of `Type::Binary`, `Type::JSON`, `Type::XML`,
+///               `Type::Flat`.
 /// @tparam Ts    Deduced from the values passed; any serializable type is accepted.
 /// @param options  Serialization options controlling checksum, compression, encryption, and
 ///                 text formatting.
@@ -354,6 +1235,116 @@ std::string serialize(const SerializeOptions& options, Ts&&... ts)
     return Impl::serialize<type>(options, std::forward<Ts>(ts)...);
 }
 
+/// Computes the exact number of bytes that `serialize<Type::Binary>(options, ts...)` would return,
+/// without writing any of them. The values are walked with the same rules the binary serializer
+/// uses, but only sizes are accumulated, so continuous arithmetic containers (such as
+/// `std::vector<float>`) are measured in O(1).
+///
+/// The result includes the header (4 bytes, or 8 when `options.enableChecksum` is true). The size
+/// of compressed or encrypted output cannot be known without producing it, so enabling either
+/// feature throws `Serio::Exception`.
+///
+/// @param options  Serialization options; only `enableChecksum`, `varint` and `trackPointers` affect the result.
+/// @param ts       One or more values to measure.
+/// @returns The total size of the binary output in bytes, including the header.
+template <typename... Ts>
+Size serializedSize(const SerializeOptions& options, const Ts&... ts)
+{
+    SERIO_ASSERT(options.compressLevel < 0, "Serialized size is not known in advance when compression is enabled");
+    SERIO_ASSERT(options.encryptPassword.empty(), "Serialized size is not known in advance when encryption is enabled");
+    Size header = 4 + (options.enableChecksum ? 4 : 0);
+    bool tracked = options.trackPointers;
+    if (options.varint)
+        return header + Impl::BasicSizeSerializer<Impl::VarintEncoding>().tracking(tracked).process(ts...).size();
+    return header + Impl::SizeSerializer().tracking(tracked).process(ts...).size();
+}
+
+/// Serializes one or more values in binary form, header included, directly into the caller-owned
+/// memory `[data, data + capacity)`. No intermediate string is allocated: the values are measured
+/// first, exactly like `serializedSize()`, and then written in place. When the output does not fit,
+/// nothing is written and the returned result carries the required size, so the caller can grow
+/// its buffer and try again.
+///
+/// Compressed or encrypted output cannot be measured in advance; with those options the output
+/// is produced internally and copied into `data` if it fits.
+///
+/// @param options   Serialization options; `compactFrom` and `presize` are ignored.
+/// @param data      Start of the destination memory.
+/// @param capacity  Number of bytes available at `data`.
+/// @param ts        One or more values to serialize.
+/// @returns The number of bytes written, or the number of bytes needed when `capacity` is too small.
+template <typename... Ts>
+SerializeResult serializeInto(const SerializeOptions& options, char* data, Size capacity, Ts&&... ts)
+{
+    if (options.varint)
+        return options.bigEndian
+                   ? Impl::serializeInto<Impl::BigVarintEncoding>(options, data, capacity, std::forward<Ts>(ts)...)
+                   : Impl::serializeInto<Impl::VarintEncoding>(options, data, capacity, std::forward<Ts>(ts)...);
+    return options.bigEndian
+               ? Impl::serializeInto<Impl::BigFixedEncoding>(options, data, capacity, std::forward<Ts>(ts)...)
+               : Impl::serializeInto<Impl::FixedEncoding>(options, data, capacity, std::forward<Ts>(ts)...);
+}
+
+/// Serializes one or more values in binary form and appends them to `buffer`, which grows once to
+/// the measured size. Call `buffer.clear()` between messages to reuse its memory for the next one.
+///
+/// @param options  Serialization options; `compactFrom` and `presize` are ignored.
+/// @param buffer   The buffer to append to. Existing contents are kept.
+/// @param ts       One or more values to serialize.
+/// @returns The number of bytes appended.
+template <typename Allocator, typename... Ts>
+Size serializeInto(const SerializeOptions& options, BasicBuffer<Allocator>& buffer, Ts&&... ts)
+{
+    if (options.varint)
+        return options.bigEndian
+                   ? Impl::serializeAppend<Impl::BigVarintEncoding>(options, buffer, std::forward<Ts>(ts)...)
+                   : Impl::serializeAppend<Impl::VarintEncoding>(options, buffer, std::forward<Ts>(ts)...);
+    return options.bigEndian ? Impl::serializeAppend<Impl::BigFixedEncoding>(options, buffer, std::forward<Ts>(ts)...)
+                             : Impl::serializeAppend<Impl::FixedEncoding>(options, buffer, std::forward<Ts>(ts)...);
+}
+
+/// Serializes one or more values in binary form and appends them to the scatter-gather list
+/// `segments`. Fields are copied into the list's staging buffer, except for continuous blocks of at
+/// least `segments.threshold()` bytes, which are referenced in place; the values must therefore
+/// outlive the use of the segments. Compressed or encrypted output is produced internally and
+/// copied into the staging buffer as a whole.
+///
+/// @param options   Serialization options; `compactFrom` and `presize` are ignored.
+/// @param segments  The list to append to. Existing segments are kept.
+/// @param ts        One or more values to serialize.
+/// @returns The number of bytes appended.
+template <typename... Ts>
+Size serializeInto(const SerializeOptions& options, Segments& segments, Ts&&... ts)
+{
+    if (options.varint)
+        return options.bigEndian
+                   ? Impl::serializeSegments<Impl::BigVarintEncoding>(options, segments, std::forward<Ts>(ts)...)
+                   : Impl::serializeSegments<Impl::VarintEncoding>(options, segments, std::forward<Ts>(ts)...);
+    return options.bigEndian
+               ? Impl::serializeSegments<Impl::BigFixedEncoding>(options, segments, std::forward<Ts>(ts)...)
+               : Impl::serializeSegments<Impl::FixedEncoding>(options, segments, std::forward<Ts>(ts)...);
+}
+
+#if SERIO_CPP_VERSION >= 201703L
+/// Serializes one or more values in binary form and appends them to `vector`. Behaves like the
+/// `BasicBuffer` overload, except that the appended bytes are zero-filled before being written.
+///
+/// @param options  Serialization options; `compactFrom` and `presize` are ignored.
+/// @param vector   The vector to append to. Existing contents are kept.
+/// @param ts       One or more values to serialize.
+/// @returns The number of bytes appended.
+template <typename Allocator, typename... Ts>
+Size serializeInto(const SerializeOptions& options, std::vector<std::byte, Allocator>& vector, Ts&&... ts)
+{
+    if (options.varint)
+        return options.bigEndian
+                   ? Impl::serializeAppend<Impl::BigVarintEncoding>(options, vector, std::forward<Ts>(ts)...)
+                   : Impl::serializeAppend<Impl::VarintEncoding>(options, vector, std::forward<Ts>(ts)...);
+    return options.bigEndian ? Impl::serializeAppend<Impl::BigFixedEncoding>(options, vector, std::forward<Ts>(ts)...)
+                             : Impl::serializeAppend<Impl::FixedEncoding>(options, vector, std::forward<Ts>(ts)...);
+}
+#endif
+
 /// Deserializes one or more values from the byte buffer `data` using the format selected by
 /// `type`. The values are filled in the same order they were passed to `serialize`. The buffer
 /// must begin with a valid Serio header (for binary) or be a complete JSON/XML document; passing
@@ -376,10 +1367,45 @@ void deserialize(const DeserializeOptions& options, StringView data, Ts&&... ts)
     Impl::deserialize<type>(options, data, std::forward<Ts>(ts)...);
 }
 
+/// Checks in one pass that the binary buffer `data` holds values of the types `Ts`, in order, as
+/// `deserialize()` would read them: the header and checksum, every length against the input and
+/// against `options.maxLength`, and the ids of variants, derived classes and tracked pointers. The
+/// values are stepped over like `Serio::skip()` does, so little more than objects behind tracked
+/// pointers is constructed. Once a buffer passes, it can be decoded any number of times with
+/// `options.trusted` set, which skips those checks.
+///
+/// @tparam type  The serialization format; only `Type::Binary` is supported.
+/// @tparam Ts    The types of the values in the buffer, named explicitly.
+/// @param options  Deserialization options; `maxLength` and `decryptPassword` are respected and
+///                 `trusted` is ignored.
+/// @param data     A `StringView` over the complete serialized buffer, including the header.
+/// @returns True when `deserialize()` would read the values without throwing.
+template <Type type, typename... Ts>
+bool validate(const DeserializeOptions& options, StringView data)
+{
+    static_assert(type == Type::Binary, "Only binary data can be validated.");
+    DeserializeOptions checked = options;
+    checked.trusted = false;
+    try
+    {
+        Impl::deserialize<type>(checked, data, Serio::skip<Ts>()...);
+        return true;
+    }
+    catch (const Exception&)
+    {
+        return false;
+    }
+}
+
 /// Serializes one or more values and writes the result to the file at `path`, creating or
 /// truncating the file. This is a convenience wrapper around `serialize()` followed by a file
-/// write; the full serialized buffer is held in memory before writing. Throws `Serio::Exception`
-/// if the file cannot be opened for writing.
+/// write; unless `options.mapFile` is set, the full serialized buffer is held in memory before
+/// writing. Throws `Serio::Exception` if the file cannot be opened for writing.
+///
+/// On Unix-like platforms the file is written through a raw file descriptor: its space is reserved
+/// with `posix_fallocate` where available, `options.directIO` bypasses the page cache and
+/// `options.syncFile` flushes the file to disk before returning. With `options.mapFile`, binary
+/// output is serialized straight into a memory mapping of the file instead of a string.
 ///
 /// All `SerializeOptions` fields are respected, including checksum, compression, and encryption.
 ///
@@ -390,8 +1416,14 @@ void deserialize(const DeserializeOptions& options, StringView data, Ts&&... ts)
 template <Type type, typename... Ts>
 void save(const SerializeOptions& options, const std::string& path, Ts&&... ts)
 {
+#ifdef SERIO_UNIX
+    if (options.mapFile && Impl::saveMapped<type>(options, path, ts...)) return;
+    auto data = serialize<type>(options, std::forward<Ts>(ts)...);
+    SERIO_ASSERT(Impl::writeFile(options, path, data), "Failed to open file for writing");
+#else
     auto data = serialize<type>(options, std::forward<Ts>(ts)...);
     SERIO_ASSERT(Impl::writeFile(path, data), "Failed to open file for writing");
+#endif
 }
 
 /// Reads the file at `path` and deserializes one or more values from its contents. On Unix-like
@@ -399,6 +1431,9 @@ void save(const SerializeOptions& options, const std::string& path, Ts&&... ts)
 /// buffer; on other platforms it is read into a `std::string` first. Throws `Serio::Exception`
 /// if the file cannot be opened or if the contents are invalid.
 ///
+/// The `map` fields of `options` tune the mapping: access hints for the kernel, populating it up
+/// front, huge pages, and releasing the pages decoding has moved past.
+///
 /// All `DeserializeOptions` fields are respected, including the `maxLength` guard and the
 /// decryption password.
 ///
@@ -409,10 +1444,13 @@ void save(const SerializeOptions& options, const std::string& path, Ts&&... ts)
 template <Type type, typename... Ts>
 void load(const DeserializeOptions& options, const std::string& path, Ts&&... ts)
 {
+    SERIO_ASSERT(!options.zeroCopy, "Views can't outlive load(); deserialize from a FileMapping instead");
+    if (type == Type::Binary && options.prefetch > 0 && Impl::loadPrefetched(options, path, ts...)) return;
+
 #ifdef SERIO_UNIX
     Impl::MappedFile file;
-    SERIO_ASSERT(file.open(path), "Failed to open file for reading");
-    deserialize<type>(options, file.view(), std::forward<Ts>(ts)...);
+    SERIO_ASSERT(file.open(path, Impl::mapAdvice(options)), "Failed to open file for reading");
+    Impl::deserializeMapped<type>(options, file, std::forward<Ts>(ts)...);
 #else
     std::string data;
     SERIO_ASSERT(Impl::readFile(path, data), "Failed to open file for reading");
@@ -441,7 +1479,6 @@ void write(const SerializeOptions& options, std::ostream& stream, Ts&&... ts)
     SERIO_ASSERT(!options.enableChecksum, "Checksum is not supported in stream mode");
     SERIO_ASSERT(options.compressLevel < 0, "Compression is not supported in stream mode");
     SERIO_ASSERT(options.encryptPassword.empty(), "Encryption is not supported in stream mode");
-    if (type == Type::Binary) Impl::writeHeader(stream);
     Impl::write<type>(options, stream, std::forward<Ts>(ts)...);
 }
 
@@ -459,15 +1496,51 @@ void write(const SerializeOptions& options, std::ostream& stream, Ts&&... ts)
 template <Type type, typename... Ts>
 void read(const DeserializeOptions& options, std::istream& stream, Ts&&... ts)
 {
-    if (type == Type::Binary)
-    {
-        uint8_t flags;
-        Impl::readHeader(stream, flags);
-        bool compress = flags & Impl::Flags::Compress;
-        bool encrypt = flags & Impl::Flags::Encrypt;
-        SERIO_ASSERT(!compress, "Decompression is not supported in stream mode");
-        SERIO_ASSERT(!encrypt, "Decryption is not supported in stream mode");
-    }
     Impl::read<type>(options, stream, std::forward<Ts>(ts)...);
 }
+
+#ifdef SERIO_UNIX
+/// Serializes one or more values and writes the output to the POSIX file descriptor `fd`, which
+/// may be a file, pipe or socket the caller already owns. Binary output goes through an aligned
+/// buffer of `options.streamBuffer` bytes straight to `write(2)`, without `FILE*` or iostreams;
+/// JSON and XML documents are produced in memory first and written in one piece. The descriptor
+/// is neither closed nor rewound.
+///
+/// When `fd` was opened with `O_DIRECT`, binary output is written in whole aligned blocks and
+/// `O_DIRECT` is turned off only while the final tail is written. With `options.presize`, the space
+/// the output needs is reserved on regular files before writing, and `options.syncFile` flushes it
+/// to disk before returning. Checksum, compression, and encryption are not supported, as in stream
+/// mode.
+///
+/// @tparam type  The serialization format.
+/// @param options  Serialization options. `enableChecksum` must be false, `compressLevel` must
+///                 be -1, and `encryptPassword` must be empty.
+/// @param fd       The file descriptor to write to.
+/// @param ts       One or more values to serialize.
+template <Type type, typename... Ts>
+void write(const SerializeOptions& options, int fd, Ts&&... ts)
+{
+    SERIO_ASSERT(!options.enableChecksum, "Checksum is not supported in stream mode");
+    SERIO_ASSERT(options.compressLevel < 0, "Compression is not supported in stream mode");
+    SERIO_ASSERT(options.encryptPassword.empty(), "Encryption is not supported in stream mode");
+    Impl::write<type>(options, fd, std::forward<Ts>(ts)...);
+    SERIO_ASSERT(!options.syncFile || Impl::syncFile(fd), "Failed to sync file descriptor");
+}
+
+/// Reads and deserializes one or more values from the POSIX file descriptor `fd`. Binary input is
+/// read with `read(2)` into an aligned window of `options.streamBuffer` bytes, after advising the
+/// kernel of sequential access; JSON and XML input is read to the end first. Bytes read past the
+/// last value are given back by seeking on files, but stay consumed on pipes and sockets, so use
+/// a descriptor that carries nothing after the payload there. `options.prefetch` has no effect.
+///
+/// @tparam type  The serialization format matching the one used when writing to the descriptor.
+/// @param options  Deserialization options; `maxLength` and `streamBuffer` are relevant.
+/// @param fd       The file descriptor to read from.
+/// @param ts       One or more output variables to fill.
+template <Type type, typename... Ts>
+void read(const DeserializeOptions& options, int fd, Ts&&... ts)
+{
+    Impl::read<type>(options, fd, std::forward<Ts>(ts)...);
+}
+#endif
 }  // namespace Serio
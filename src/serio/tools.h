@@ -34,6 +34,8 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cerrno>
 #include <cmath>
 #include <codecvt>
 #include <cstdint>
@@ -41,6 +43,7 @@
 #include <cstring>
 #include <deque>
 #include <forward_list>
+#include <ios>
 #include <iterator>
 #include <limits>
 #include <list>
@@ -50,7 +53,9 @@
 #include <queue>
 #include <set>
 #include <stack>
+#include <streambuf>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
@@ -65,9 +70,25 @@
 #endif
 //
 #if SERIO_CPP_VERSION >= 202002L
+#include <bit>
 #include <span>
 #endif
 //
+#ifdef _MSC_VER
+#include <stdlib.h>
+#endif
+//
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SERIO_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+//
 // #if SERIO_CPP_VERSION >= 202302L
 // #include <flat_map>
 // #include <flat_multimap>
@@ -89,35 +110,259 @@ namespace Serio
 namespace Impl
 {
 #ifdef SERIO_UNIX
+/// Access hints for a `MappedFile`. Hints the platform doesn't know are ignored.
+struct MapAdvice
+{
+    bool sequential{false};  // MADV_SEQUENTIAL: read ahead aggressively, drop pages behind
+    bool willNeed{false};    // MADV_WILLNEED and readahead(): start reading the whole file now
+    bool populate{false};    // MAP_POPULATE: fault every page in before open() returns
+    bool hugePages{false};   // MADV_HUGEPAGE: back the mapping with transparent huge pages
+    Size release{0};         // drop consumed pages every `release` bytes; 0 keeps them
+};
+
+/// Read-only private mapping of a file, the input of `load()` on Unix-like platforms.
 struct MappedFile
 {
-    bool open(const std::string& path)
+    bool open(const std::string& path, const MapAdvice& advice = MapAdvice())
     {
         file = ::open(path.c_str(), O_RDONLY);
         if (file == -1) return false;
         struct stat stats;
         if (fstat(file, &stats) == -1) return false;
         if (stats.st_size == 0) return false;
-        auto addr = mmap(NULL, stats.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        if (advice.populate) flags |= MAP_POPULATE;
+#endif
+#ifdef __linux__
+        if (advice.willNeed) readahead(file, 0, size_t(stats.st_size));
+#endif
+        auto addr = mmap(NULL, stats.st_size, PROT_READ, flags, file, 0);
         if (addr == MAP_FAILED) return false;
         data = StringView((const char*)addr, stats.st_size);
+
+#ifdef MADV_HUGEPAGE
+        if (advice.hugePages) madvise(addr, data.size, MADV_HUGEPAGE);
+#endif
+        if (advice.sequential) madvise(addr, data.size, MADV_SEQUENTIAL);
+        if (advice.willNeed) madvise(addr, data.size, MADV_WILLNEED);
+        released = data.data;
+        step = advice.release;
+        next = released + std::min(step > 0 ? step : data.size, data.size);
         return true;
     }
 
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
     ~MappedFile()
     {
         if (data.data) munmap(const_cast<char*>(data.data), data.size);
         if (file != -1) close(file);
     }
 
-    StringView view() { return data; }
+    StringView view() const { return data; }
+
+    /// Tells the mapping that the bytes before `ptr` won't be read again. Once `release` bytes of
+    /// whole pages have piled up behind it, they are dropped from the process and the page cache;
+    /// touching them again reads them back from the file.
+    void consumed(const char* ptr)
+    {
+        if (ptr < next || step == 0) return;
+        auto page = Size(sysconf(_SC_PAGESIZE));
+        const char* end = data.data + Size(ptr - data.data) / page * page;
+        if (end > released)
+        {
+            madvise(const_cast<char*>(released), Size(end - released), MADV_DONTNEED);
+#ifdef POSIX_FADV_DONTNEED
+            posix_fadvise(file, off_t(released - data.data), off_t(end - released), POSIX_FADV_DONTNEED);
+#endif
+        }
+        released = end;
+        next = end + std::min(step, Size(data.data + data.size - end));
+    }
 
 private:
     int file{-1};
     StringView data{nullptr, Size(0)};
+    const char* released{nullptr};
+    const char* next{nullptr};
+    Size step{0};
+};
+
+/// Reserves `size` bytes of disk space for the regular file `fd` from its current offset, so that
+/// the file system can lay it out in large extents before it is written. Does nothing for other
+/// descriptors and on platforms without `posix_fallocate`.
+inline void preallocateFile(int fd, Size size)
+{
+#ifdef __linux__
+    struct stat stats;
+    if (size == 0 || fstat(fd, &stats) == -1 || !S_ISREG(stats.st_mode)) return;
+    auto offset = lseek(fd, 0, SEEK_CUR);
+    if (offset != -1) posix_fallocate(fd, offset, off_t(size));
+#else
+    (void)fd, (void)size;
+#endif
+}
+
+/// Tells the kernel that `fd` is about to be read sequentially, so it reads ahead more eagerly.
+inline void adviseSequential(int fd)
+{
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#else
+    (void)fd;
+#endif
+}
+
+/// Flushes the data written to `fd` to stable storage. Returns false on failure.
+inline bool syncFile(int fd)
+{
+#ifdef __APPLE__
+    return fsync(fd) == 0;
+#else
+    return fdatasync(fd) == 0;
+#endif
+}
+
+/// Turns `O_DIRECT` off for `fd`, for transfers that don't meet its alignment rules. Returns the
+/// flags `fd` had before, or -1 when nothing was changed.
+inline int clearDirect(int fd)
+{
+#ifdef O_DIRECT
+    int flags = fcntl(fd, F_GETFL);
+    if (flags != -1 && (flags & O_DIRECT) && fcntl(fd, F_SETFL, flags & ~O_DIRECT) != -1) return flags;
+#else
+    (void)fd;
+#endif
+    return -1;
+}
+
+/// Gives `fd` back the `flags` that `clearDirect()` returned; does nothing for -1.
+inline void restoreFlags(int fd, int flags)
+{
+    if (flags != -1) fcntl(fd, F_SETFL, flags);
+}
+
+/// True when `fd` was opened with `O_DIRECT`.
+inline bool isDirect(int fd)
+{
+#ifdef O_DIRECT
+    int flags = fcntl(fd, F_GETFL);
+    return flags != -1 && (flags & O_DIRECT);
+#else
+    (void)fd;
+    return false;
+#endif
+}
+
+/// Writable shared mapping of a file that is filled in place, so the data never exists in a heap
+/// buffer as well. The file grows in large steps, reserving disk space with `posix_fallocate` where
+/// available so a full disk surfaces as an error rather than a fault, and is cut to the bytes
+/// taken on `close()`.
+struct MappedFileWriter
+{
+    bool open(const std::string& path, Size size)
+    {
+        file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+        return file != -1 && (size == 0 || resize(size));
+    }
+
+    ~MappedFileWriter()
+    {
+        if (data) munmap(data, capacity);
+        if (file != -1) ::close(file);
+    }
+
+    /// Hands out the next `size` bytes of the file, growing it when needed. The pointer is valid
+    /// until the next call, which may move the mapping.
+    char* take(Size size)
+    {
+        if (size > capacity - used)
+            SERIO_ASSERT(resize(std::max(used + size, std::max(capacity * 2, Size(1) << 20))),
+                         "Failed to grow mapped file");
+        char* ptr = data + used;
+        used += size;
+        return ptr;
+    }
+
+    char* begin() { return data; }
+    Size size() const { return used; }
+
+    /// Unmaps the file and cuts it to the bytes taken, flushing them to disk first when `sync` is
+    /// set. Returns false on failure.
+    bool close(bool sync)
+    {
+        bool done = true;
+        if (data && sync) done = msync(data, used, MS_SYNC) == 0;
+        if (data) munmap(data, capacity);
+        data = nullptr;
+        done = done && ftruncate(file, off_t(used)) == 0 && (!sync || syncFile(file));
+        done = ::close(file) == 0 && done;
+        file = -1;
+        return done;
+    }
+
+private:
+    bool resize(Size size)
+    {
+#ifdef __linux__
+        if (posix_fallocate(file, 0, off_t(size)) != 0) return false;
+#else
+        if (ftruncate(file, off_t(size)) != 0) return false;
+#endif
+        void* addr = MAP_FAILED;
+#ifdef __linux__
+        if (data) addr = mremap(data, capacity, size, MREMAP_MAYMOVE);
+#else
+        if (data) munmap(data, capacity), data = nullptr;
+#endif
+        if (!data) addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        if (addr == MAP_FAILED) return false;
+        data = (char*)addr;
+        capacity = size;
+        return true;
+    }
+
+    int file{-1};
+    char* data{nullptr};
+    Size capacity{0}, used{0};
 };
 #endif
 
+/// A heap block whose start is aligned to `Alignment` bytes, as `O_DIRECT` transfers require. Its
+/// bytes are left uninitialized.
+class AlignedBuffer
+{
+    std::unique_ptr<char[]> _storage;
+    char* _data{nullptr};
+    Size _size{0};
+
+public:
+    enum : Size
+    {
+        Alignment = 4096
+    };
+
+    explicit AlignedBuffer(Size size = 0) { resize(size); }
+
+    char* data() { return _data; }
+    const char* data() const { return _data; }
+    Size size() const { return _size; }
+    char& operator[](Size index) { return _data[index]; }
+
+    /// Changes the size to `size` bytes, keeping the bytes that still fit.
+    void resize(Size size)
+    {
+        std::unique_ptr<char[]> storage(new char[size + Alignment]);
+        auto offset = Size(reinterpret_cast<std::uintptr_t>(storage.get()) % Alignment);
+        char* data = storage.get() + (Alignment - offset) % Alignment;
+        if (_size > 0) std::memcpy(data, _data, std::min(size, _size));
+        _storage = std::move(storage);
+        _data = data, _size = size;
+    }
+};
+
 inline bool readFile(const std::string& path, std::string& data)
 {
     struct CloseWrapper
@@ -148,19 +393,146 @@ inline bool writeFile(const std::string& path, const std::string& data)
     return written == data.size();
 }
 
-inline bool _littleEndian()
-{
-    uint32_t value = 0x01020304;
-    char data[4] = {4, 3, 2, 1}, *list = (char*)&value;
-    return data[0] == list[0] && data[1] == list[1] && data[2] == list[2] && data[3] == list[3];
-}
+/// Stream buffer that reads `source` ahead on a helper thread, so that reading the next block
+/// overlaps with decoding the current one. `count` blocks of `size` bytes rotate between the two
+/// threads, and each is handed over through an atomic state without locks. The source is read to
+/// its end; on destruction, the bytes that were read ahead but not consumed are given back to it
+/// by seeking, which only works when it can seek.
+class PrefetchBuffer : public std::streambuf
+{
+    enum : int
+    {
+        Empty,
+        Full,
+    };
 
-inline bool littleEndian()
+    struct Block
+    {
+        std::vector<char> data;
+        Size size{0};
+        std::atomic<int> state{Empty};
+    };
+
+    std::streambuf* _source;
+    std::unique_ptr<Block[]> _blocks;
+    Size _count, _next{0}, _consumed{0}, _read{0};
+    bool _held{false}, _done{false};
+    std::atomic<bool> _stop{false};
+    std::thread _thread;
+
+    static void await(const std::atomic<int>& state, int old)
+    {
+#ifdef __cpp_lib_atomic_wait
+        state.wait(old, std::memory_order_acquire);
+#else
+        while (state.load(std::memory_order_acquire) == old) std::this_thread::yield();
+#endif
+    }
+    static void publish(std::atomic<int>& state, int value)
+    {
+        state.store(value, std::memory_order_release);
+#ifdef __cpp_lib_atomic_wait
+        state.notify_one();
+#endif
+    }
+
+    void produce()
+    {
+        for (Size i = 0;; i = (i + 1) % _count)
+        {
+            Block& block = _blocks[i];
+            await(block.state, Full);
+            if (_stop.load(std::memory_order_acquire)) return;
+
+            std::streamsize size = 0;
+            try
+            {
+                size = _source->sgetn(block.data.data(), std::streamsize(block.data.size()));
+            }
+            catch (...)
+            {
+            }
+            block.size = size > 0 ? Size(size) : 0;
+            _read += block.size;
+            publish(block.state, Full);
+            if (block.size == 0) return;
+        }
+    }
+
+protected:
+    int_type underflow() override
+    {
+        if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+        if (_done) return traits_type::eof();
+        if (_held)
+        {
+            _consumed += _blocks[_next].size;
+            publish(_blocks[_next].state, Empty);
+            _next = (_next + 1) % _count;
+            _held = false;
+        }
+
+        Block& block = _blocks[_next];
+        await(block.state, Empty);
+        if (block.size == 0)
+        {
+            _done = true;
+            return traits_type::eof();
+        }
+        _held = true;
+        setg(block.data.data(), block.data.data(), block.data.data() + block.size);
+        return traits_type::to_int_type(*gptr());
+    }
+
+public:
+    PrefetchBuffer(std::streambuf* source, Size size, Size count)
+        : _source(source), _blocks(new Block[std::max<Size>(count, 2)]), _count(std::max<Size>(count, 2))
+    {
+        for (Size i = 0; i < _count; ++i) _blocks[i].data.resize(std::max<Size>(size, 16));
+        _thread = std::thread(&PrefetchBuffer::produce, this);
+    }
+    PrefetchBuffer(const PrefetchBuffer&) = delete;
+
+    ~PrefetchBuffer()
+    {
+        _stop.store(true, std::memory_order_release);
+        for (Size i = 0; i < _count; ++i) publish(_blocks[i].state, Empty);
+        _thread.join();
+
+        if (_held) _consumed += Size(gptr() - eback());
+        auto ahead = std::streamoff(_read - _consumed);
+        if (ahead > 0) _source->pubseekoff(-ahead, std::ios_base::cur, std::ios_base::in);
+    }
+};
+
+enum class ByteOrder
 {
-    static bool little = _littleEndian();
-    return little;
+    Little,
+    Big,
+    Unknown,
+};
+
+/// The byte order of the target, known at compile time. `Unknown` (for example a mixed-endian
+/// target without `std::endian`) selects portable byte-by-byte code.
+constexpr ByteOrder nativeOrder()
+{
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return ByteOrder::Little;
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return ByteOrder::Big;
+#elif defined(__cpp_lib_endian)
+    return std::endian::native == std::endian::little ? ByteOrder::Little
+           : std::endian::native == std::endian::big  ? ByteOrder::Big
+                                                      : ByteOrder::Unknown;
+#elif defined(_MSC_VER)
+    return ByteOrder::Little;
+#else
+    return ByteOrder::Unknown;
+#endif
 }
 
+constexpr bool littleEndian() { return nativeOrder() == ByteOrder::Little; }
+
 inline Size b64encSize(Size size) { return (size + 2) / 3 * 4; }
 
 inline void base64Encode(const uint8_t* input, char* output, Size size)
@@ -265,7 +637,7 @@ void fromutf8(const std::string& input, std::basic_string<T, Ts...>& output)
     output = convert.from_bytes(input);
 }
 
-inline uint32_t _crcCreate(const uint8_t* data, Size size)
+inline uint32_t _crcUpdate(uint32_t crc, const uint8_t* data, Size size)
 {
     const static uint32_t table[] = {
         0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F, 0xE963A535, 0x9E6495A3,  //
@@ -302,10 +674,14 @@ inline uint32_t _crcCreate(const uint8_t* data, Size size)
         0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94, 0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D,  //
     };
 
-    uint32_t crc = 0xFFFFFFFF;
     for (Size i = 0; i < size; ++i)  //
         crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
-    return ~crc;
+    return crc;
+}
+
+inline uint32_t _crcCreate(const uint8_t* data, Size size)  //
+{
+    return ~_crcUpdate(0xFFFFFFFF, data, size);
 }
 
 inline uint32_t crcCreate(StringView input)  //
@@ -313,6 +689,22 @@ inline uint32_t crcCreate(StringView input)  //
     return _crcCreate((const uint8_t*)input.data, input.size);
 }
 
+inline uint32_t crcCreate(const Segments& segments, Size offset)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (const auto& segment : segments.segments())
+    {
+        if (offset >= segment.size)
+        {
+            offset -= segment.size;
+            continue;
+        }
+        crc = _crcUpdate(crc, (const uint8_t*)segment.data + offset, segment.size - offset);
+        offset = 0;
+    }
+    return ~crc;
+}
+
 #ifdef SERIO_USE_COMPRESSION
 SERIO_API void compress(StringView input, std::string& output, int level, Size header);
 SERIO_API void decompress(StringView input, std::string& output);
@@ -420,20 +812,62 @@ struct _BasicType<0>
         data |= T(*ptr);
     }
 };
-struct BasicType
+inline uint8_t byteSwap(uint8_t value) { return value; }
+inline uint16_t byteSwap(uint16_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap16(value);
+#elif defined(_MSC_VER)
+    return _byteswap_ushort(value);
+#else
+    return uint16_t((value << 8) | (value >> 8));
+#endif
+}
+inline uint32_t byteSwap(uint32_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap32(value);
+#elif defined(_MSC_VER)
+    return _byteswap_ulong(value);
+#else
+    value = ((value << 8) & 0xFF00FF00u) | ((value >> 8) & 0x00FF00FFu);
+    return (value << 16) | (value >> 16);
+#endif
+}
+inline uint64_t byteSwap(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(value);
+#elif defined(_MSC_VER)
+    return _byteswap_uint64(value);
+#else
+    return (uint64_t(byteSwap(uint32_t(value))) << 32) | byteSwap(uint32_t(value >> 32));
+#endif
+}
+#ifdef __SIZEOF_INT128__
+inline unsigned __int128 byteSwap(unsigned __int128 value)
+{
+    return ((unsigned __int128)byteSwap(uint64_t(value)) << 64) | byteSwap(uint64_t(value >> 64));
+}
+#endif
+
+/// Stores arithmetic values in the byte order `Order`. On targets with a known byte order this is
+/// a single unaligned load or store, with a byte swap only when `Order` is not the native one.
+template <ByteOrder Order>
+struct OrderedType
 {
     template <typename T>
     static EnableIfT<!std::is_floating_point<T>::value, void> serialize(char* ptr, const T& data)
     {
         using Type = typename TypeMatch<sizeof(T)>::Type;
-        _BasicType<(sizeof(T) - 1) * 8>::serialize((uint8_t*)ptr + sizeof(T) - 1, static_cast<Type>(data));
+        store(ptr, static_cast<Type>(data), Known());
     }
     template <typename T>
     static EnableIfT<!std::is_floating_point<T>::value, void> deserialize(const char* ptr, T& data)
     {
         using Type = typename TypeMatch<sizeof(T)>::Type;
         Type value = 0;
-        _BasicType<(sizeof(T) - 1) * 8>::deserialize((const uint8_t*)ptr + sizeof(T) - 1, value);
+        load(ptr, value, Known());
         data = static_cast<T>(value);
     }
 
@@ -444,7 +878,7 @@ struct BasicType
         using Type = typename TypeMatch<sizeof(T)>::Type;
         Type value;
         std::memcpy(&value, &data, sizeof(T));
-        _BasicType<(sizeof(T) - 1) * 8>::serialize((uint8_t*)ptr + sizeof(T) - 1, value);
+        store(ptr, value, Known());
     }
     template <typename T>
     static EnableIfT<std::is_floating_point<T>::value, void> deserialize(const char* ptr, T& data)
@@ -452,9 +886,209 @@ struct BasicType
         static_assert(std::numeric_limits<T>::is_iec559, "Only IEEE 754 floating point type is supported.");
         using Type = typename TypeMatch<sizeof(T)>::Type;
         Type value = 0;
-        _BasicType<(sizeof(T) - 1) * 8>::deserialize((const uint8_t*)ptr + sizeof(T) - 1, value);
+        load(ptr, value, Known());
         std::memcpy(&data, &value, sizeof(T));
     }
+
+private:
+    using Known = std::integral_constant<bool, nativeOrder() != ByteOrder::Unknown>;
+
+    template <typename U>
+    static void store(char* ptr, U value, std::true_type)
+    {
+        if (Order != nativeOrder()) value = byteSwap(value);
+        std::memcpy(ptr, &value, sizeof(U));
+    }
+    template <typename U>
+    static void load(const char* ptr, U& value, std::true_type)
+    {
+        std::memcpy(&value, ptr, sizeof(U));
+        if (Order != nativeOrder()) value = byteSwap(value);
+    }
+    template <typename U>
+    static void store(char* ptr, U value, std::false_type)
+    {
+        _BasicType<(sizeof(U) - 1) * 8>::serialize((uint8_t*)ptr + sizeof(U) - 1, value);
+        if (Order == ByteOrder::Big) std::reverse(ptr, ptr + sizeof(U));
+    }
+    template <typename U>
+    static void load(const char* ptr, U& value, std::false_type)
+    {
+        char data[sizeof(U)];
+        std::memcpy(data, ptr, sizeof(U));
+        if (Order == ByteOrder::Big) std::reverse(data, data + sizeof(U));
+        _BasicType<(sizeof(U) - 1) * 8>::deserialize((const uint8_t*)data + sizeof(U) - 1, value);
+    }
+};
+
+/// Stores arithmetic values in little-endian byte order, the default byte order of the format.
+using BasicType = OrderedType<ByteOrder::Little>;
+
+/// Reverses the bytes of each of `count` values of `N` bytes while copying them from `input` to
+/// `output`, which may be the same memory. Blocks of 32 or 16 bytes are swapped at once with AVX2,
+/// SSSE3 or SSE2 shuffles when the target has them; the remaining values are swapped one by one.
+template <Size N>
+struct ByteSwap
+{
+    static void copy(char* output, const char* input, Size count)
+    {
+        using Type = typename TypeMatch<N>::Type;
+        Size i = vector(output, input, count * N, std::integral_constant<bool, N == 2 || N == 4 || N == 8>()) / N;
+        for (; i < count; ++i)
+        {
+            Type value;
+            std::memcpy(&value, input + i * N, N);
+            value = byteSwap(value);
+            std::memcpy(output + i * N, &value, N);
+        }
+    }
+
+private:
+#if defined(__SSSE3__)
+    static __m128i mask()
+    {
+        alignas(16) char data[16];
+        for (Size i = 0; i < 16; ++i) data[i] = char(i / N * N + N - 1 - i % N);
+        return _mm_load_si128((const __m128i*)data);
+    }
+#endif
+#if defined(SERIO_SSE2) && !defined(__SSSE3__)
+    static __m128i swap(__m128i value, std::integral_constant<Size, 2>)
+    {
+        return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+    }
+    static __m128i swap(__m128i value, std::integral_constant<Size, 4>)
+    {
+        value = swap(value, std::integral_constant<Size, 2>());
+        value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+        return _mm_shufflehi_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+    }
+    static __m128i swap(__m128i value, std::integral_constant<Size, 8>)
+    {
+        value = swap(value, std::integral_constant<Size, 2>());
+        value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(0, 1, 2, 3));
+        return _mm_shufflehi_epi16(value, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+#endif
+
+    static Size vector(char*, const char*, Size, std::false_type) { return 0; }
+
+    // Swaps the leading whole blocks of `size` bytes and returns how many bytes it handled.
+    static Size vector(char* output, const char* input, Size size, std::true_type)
+    {
+        Size i = 0;
+#if defined(__AVX2__)
+        const __m256i wide = _mm256_broadcastsi128_si256(mask());
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i value = _mm256_loadu_si256((const __m256i*)(input + i));
+            _mm256_storeu_si256((__m256i*)(output + i), _mm256_shuffle_epi8(value, wide));
+        }
+#endif
+#if defined(__SSSE3__)
+        const __m128i narrow = mask();
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i value = _mm_loadu_si128((const __m128i*)(input + i));
+            _mm_storeu_si128((__m128i*)(output + i), _mm_shuffle_epi8(value, narrow));
+        }
+#elif defined(SERIO_SSE2)
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i value = _mm_loadu_si128((const __m128i*)(input + i));
+            _mm_storeu_si128((__m128i*)(output + i), swap(value, std::integral_constant<Size, N>()));
+        }
+#else
+        (void)output, (void)input, (void)size;
+#endif
+        return i;
+    }
+};
+
+/// LEB128 variable-length integers. Signed values are ZigZag-mapped first, so small magnitudes of
+/// either sign take few bytes.
+struct Varint
+{
+    enum : Size
+    {
+        MaxSize = 10,
+    };
+
+    template <typename T>
+    static EnableIfT<std::is_unsigned<T>::value, uint64_t> zigzag(T value)
+    {
+        return uint64_t(value);
+    }
+    template <typename T>
+    static EnableIfT<std::is_signed<T>::value, uint64_t> zigzag(T value)
+    {
+        return (uint64_t(int64_t(value)) << 1) ^ uint64_t(int64_t(value) >> 63);
+    }
+
+    /// Converts a decoded varint back to `T`, returning false when it is out of range for `T`.
+    template <typename T>
+    static EnableIfT<std::is_unsigned<T>::value, bool> unzigzag(uint64_t raw, T& value)
+    {
+        value = T(raw);
+        return raw <= uint64_t(std::numeric_limits<T>::max());
+    }
+    template <typename T>
+    static EnableIfT<std::is_signed<T>::value, bool> unzigzag(uint64_t raw, T& value)
+    {
+        int64_t item = int64_t(raw >> 1) ^ -int64_t(raw & 1);
+        value = T(item);
+        return item >= int64_t(std::numeric_limits<T>::min()) && item <= int64_t(std::numeric_limits<T>::max());
+    }
+
+    static Size size(uint64_t value)
+    {
+        Size size = 1;
+        for (; value >= 0x80; value >>= 7) ++size;
+        return size;
+    }
+
+    /// Writes `value` to `ptr`, which must have room for `MaxSize` bytes, and returns its size.
+    static Size encode(char* ptr, uint64_t value)
+    {
+        Size size = 0;
+        for (; value >= 0x80; value >>= 7) ptr[size++] = char(uint8_t(value) | 0x80);
+        ptr[size++] = char(value);
+        return size;
+    }
+
+    /// Reads a varint from at most `length` bytes at `ptr` and returns its size, or zero when the
+    /// input is truncated or the varint is longer than 64 bits. With eight bytes available, varints
+    /// of up to eight bytes are decoded from a single word without a per-byte loop.
+    static Size decode(const char* ptr, Size length, uint64_t& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        if (length >= 8)
+        {
+            uint64_t word;
+            BasicType::deserialize(ptr, word);
+            uint64_t stops = ~word & 0x8080808080808080ull;
+            if (stops != 0)
+            {
+                Size bits = Size(__builtin_ctzll(stops)) + 1;
+                if (bits < 64) word &= (uint64_t(1) << bits) - 1;
+                word = ((word & 0x7F007F007F007F00ull) >> 1) | (word & 0x007F007F007F007Full);
+                word = ((word & 0x3FFF00003FFF0000ull) >> 2) | (word & 0x00003FFF00003FFFull);
+                word = ((word & 0x0FFFFFFF00000000ull) >> 4) | (word & 0x000000000FFFFFFFull);
+                value = word;
+                return bits / 8;
+            }
+        }
+#endif
+        value = 0;
+        for (Size i = 0; i < length && i < MaxSize; ++i)
+        {
+            uint8_t byte = uint8_t(ptr[i]);
+            value |= uint64_t(byte & 0x7F) << (7 * i);
+            if (byte & 0x80) continue;
+            return i == MaxSize - 1 && byte > 1 ? 0 : i + 1;
+        }
+        return 0;
+    }
 };
 
 struct Bitset
@@ -603,6 +1237,12 @@ public:
     using std::priority_queue<Ts...>::c;
 };
 
+/// Element types that contiguous containers can copy in bulk on little-endian hosts.
+template <typename T>
+struct IsBulk : std::integral_constant<bool, std::is_arithmetic<T>::value || IsTriviallySerializable<T>::value>
+{
+};
+
 template <typename T>
 struct IsContinuous : std::false_type
 {
@@ -612,36 +1252,36 @@ struct IsContinuous<std::vector<bool, Ts...>> : std::false_type
 {
 };
 template <typename T, typename... Ts>
-struct IsContinuous<std::vector<T, Ts...>> : std::is_arithmetic<T>
+struct IsContinuous<std::vector<T, Ts...>> : IsBulk<T>
 {
 };
 template <typename T, typename... Ts>
-struct IsContinuous<std::basic_string<T, Ts...>> : std::is_arithmetic<T>
+struct IsContinuous<std::basic_string<T, Ts...>> : IsBulk<T>
 {
 };
 template <typename T, size_t N>
-struct IsContinuous<std::array<T, N>> : std::is_arithmetic<T>
+struct IsContinuous<std::array<T, N>> : IsBulk<T>
 {
 };
 template <typename T>
-struct IsContinuous<PointerView<T>> : std::is_arithmetic<T>
+struct IsContinuous<PointerView<T>> : IsBulk<T>
 {
 };
 template <typename T, size_t N>
-struct IsContinuous<StaticArrayView<T, N>> : std::is_arithmetic<T>
+struct IsContinuous<StaticArrayView<T, N>> : IsBulk<T>
 {
 };
 
 #if SERIO_CPP_VERSION >= 201703L
 template <typename T, typename... Ts>
-struct IsContinuous<std::basic_string_view<T, Ts...>> : std::is_arithmetic<T>
+struct IsContinuous<std::basic_string_view<T, Ts...>> : IsBulk<T>
 {
 };
 #endif
 
 #if SERIO_CPP_VERSION >= 202002L
 template <typename T, size_t S>
-struct IsContinuous<std::span<T, S>> : std::is_arithmetic<T>
+struct IsContinuous<std::span<T, S>> : IsBulk<T>
 {
 };
 #endif
@@ -679,17 +1319,17 @@ struct IsFixedContinuous : std::false_type
 {
 };
 template <typename T, size_t N>
-struct IsFixedContinuous<std::array<T, N>> : std::is_arithmetic<T>
+struct IsFixedContinuous<std::array<T, N>> : IsBulk<T>
 {
 };
 template <typename T, size_t N>
-struct IsFixedContinuous<StaticArrayView<T, N>> : std::is_arithmetic<T>
+struct IsFixedContinuous<StaticArrayView<T, N>> : IsBulk<T>
 {
 };
 
 #if SERIO_CPP_VERSION >= 202002L
 template <typename T, size_t S>
-struct IsFixedContinuous<std::span<T, S>> : std::is_arithmetic<T>
+struct IsFixedContinuous<std::span<T, S>> : IsBulk<T>
 {
 };
 template <typename T>
@@ -199,6 +199,11 @@ struct XmlSerializer : public Base::Serializer, public Base::XML
         return serialize(value.load());
     }
     template <typename T>
+    Node serialize(const Indexed<T>& value)
+    {
+        return serialize(value.value);
+    }
+    template <typename T>
     Node serialize(const BinaryString<T>& value)
     {
         return serializeBinary(value.value.data(), value.value.size());
@@ -517,6 +522,11 @@ struct XmlDeserializer : public Base::Deserializer, public Base::XML
         value.store(iget<T>(item));
     }
     template <typename T>
+    void deserialize(Node item, Indexed<T> value)
+    {
+        deserialize(item, value.value);
+    }
+    template <typename T>
     void deserialize(Node item, BinaryString<T> value)
     {
         auto input = item->value();
@@ -647,6 +657,21 @@ public:
         node = node->next_sibling();
         return *this;
     }
+    template <typename T>
+    Derived& operator>>(Indexed<T> value)
+    {
+        SERIO_ASSERT(node, "Request more items from a finished xml deserializer");
+        deserialize(node, value);
+        node = node->next_sibling();
+        return *this;
+    }
+    template <typename T>
+    Derived& operator>>(Skip<T>)
+    {
+        SERIO_ASSERT(node, "Request more items from a finished xml deserializer");
+        node = node->next_sibling();
+        return *this;
+    }
     template <typename T, Size N>
     Derived& operator>>(StaticArrayView<T, N> value)
     {
@@ -311,3 +311,150 @@ TEST(API, BraceInitOptions)
     Serio::deserialize<Serio::Binary>({}, bytes, out);
     EXPECT_EQ(out, "test");
 }
+
+// ---- serializedSize ----
+
+TEST(API, SerializedSizeScalar)
+{
+    EXPECT_EQ(Serio::serializedSize({}, int32_t(7)), Serio::serialize<Serio::Binary>({}, int32_t(7)).size());
+}
+
+TEST(API, SerializedSizeMatchesOutput)
+{
+    std::map<std::string, std::vector<Point3D>> value{{"a", {{1, 2, 3}}}, {"bcd", {{4, 5, 6}, {7, 8, 9}}}};
+    std::vector<bool> bits{true, false, true};
+    std::optional<std::string> name = "serio";
+    auto bytes = Serio::serialize<Serio::Binary>({}, value, bits, name);
+    EXPECT_EQ(Serio::serializedSize({}, value, bits, name), bytes.size());
+}
+
+TEST(API, SerializedSizeWithChecksum)
+{
+    Serio::SerializeOptions sopt;
+    sopt.enableChecksum = true;
+    std::vector<int> value{1, 2, 3};
+    EXPECT_EQ(Serio::serializedSize(sopt, value), Serio::serialize<Serio::Binary>(sopt, value).size());
+}
+
+TEST(API, SerializedSizeContinuous)
+{
+    std::vector<double> value(1 << 20);
+    EXPECT_EQ(Serio::serializedSize({}, value), 4 + sizeof(Serio::Size) + value.size() * sizeof(double));
+}
+
+TEST(API, SerializedSizeRejectsCompression)
+{
+    Serio::SerializeOptions sopt;
+    sopt.compressLevel = 3;
+    EXPECT_THROW(Serio::serializedSize(sopt, 1), Serio::Exception);
+}
+
+// ---- serializeInto ----
+
+TEST(API, SerializeIntoPointer)
+{
+    std::map<std::string, std::vector<Point3D>> value{{"a", {{1, 2, 3}}}, {"bcd", {{4, 5, 6}}}};
+    auto expected = Serio::serialize<Serio::Binary>({}, value);
+
+    char data[256];
+    auto result = Serio::serializeInto({}, data, sizeof(data), value);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(std::string(data, result.size), expected);
+}
+
+TEST(API, SerializeIntoPointerTooSmall)
+{
+    std::vector<int32_t> value{1, 2, 3, 4};
+    Serio::Size needed = Serio::serializedSize({}, value);
+
+    std::string data(needed - 1, 'x');
+    auto result = Serio::serializeInto({}, &data[0], data.size(), value);
+    EXPECT_FALSE(result);
+    EXPECT_EQ(result.size, needed);
+    EXPECT_EQ(data, std::string(needed - 1, 'x'));
+
+    data.resize(needed);
+    EXPECT_TRUE(Serio::serializeInto({}, &data[0], data.size(), value));
+    EXPECT_EQ(data, Serio::serialize<Serio::Binary>({}, value));
+}
+
+TEST(API, SerializeIntoWithOptions)
+{
+    std::vector<std::string> value{"alpha", "beta", "gamma"};
+    char data[512];
+    for (int i = 0; i < 4; ++i)
+    {
+        Serio::SerializeOptions sopt;
+        sopt.enableChecksum = i & 1;
+        sopt.varint = i & 2;
+        auto result = Serio::serializeInto(sopt, data, sizeof(data), value);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(std::string(data, result.size), Serio::serialize<Serio::Binary>(sopt, value));
+    }
+}
+
+// Writes one more value every time it is serialized, so it measures less than it writes.
+struct Growing
+{
+    mutable int calls = 0;
+
+    SERIO_FRIEND;
+
+    template <typename S>
+    void _serialize(S& C) const
+    {
+        for (int i = 0; i <= calls; ++i) C << int32_t(i);
+        ++calls;
+    }
+};
+
+TEST(API, SerializeIntoSizeMismatchThrows)
+{
+    char data[256];
+    Growing value;
+    EXPECT_THROW(Serio::serializeInto({}, data, sizeof(data), value), Serio::Exception);
+}
+
+#ifdef SERIO_USE_COMPRESSION
+TEST(API, SerializeIntoCompressed)
+{
+    std::vector<std::string> value{"alpha", "beta", "gamma"};
+    char data[512];
+    Serio::SerializeOptions sopt;
+    sopt.compressLevel = 3;
+    auto result = Serio::serializeInto(sopt, data, sizeof(data), value);
+    ASSERT_TRUE(result);
+    std::vector<std::string> out;
+    Serio::deserialize<Serio::Binary>({}, Serio::StringView(data, result.size), out);
+    EXPECT_EQ(out, value);
+}
+#endif
+
+TEST(API, SerializeIntoBufferAppends)
+{
+    Serio::Buffer buffer;
+    Serio::Size first = Serio::serializeInto({}, buffer, std::string("one"));
+    Serio::Size second = Serio::serializeInto({}, buffer, 2.5, 7);
+    EXPECT_EQ(buffer.size(), first + second);
+
+    std::string name;
+    double d;
+    int i;
+    Serio::deserialize<Serio::Binary>({}, Serio::StringView(buffer.data(), first), name);
+    Serio::deserialize<Serio::Binary>({}, Serio::StringView(buffer.data() + first, second), d, i);
+    EXPECT_EQ(name, "one");
+    EXPECT_EQ(d, 2.5);
+    EXPECT_EQ(i, 7);
+
+    buffer.clear();
+    EXPECT_EQ(Serio::serializeInto({}, buffer, std::string("one")), first);
+}
+
+TEST(API, SerializeIntoByteVector)
+{
+    std::vector<Point3D> value{{1, 2, 3}, {4, 5, 6}};
+    std::vector<std::byte> bytes{std::byte(0xAA)};
+    Serio::Size size = Serio::serializeInto({}, bytes, value);
+    ASSERT_EQ(bytes.size(), size + 1);
+    EXPECT_EQ(std::string((const char*)bytes.data() + 1, size), Serio::serialize<Serio::Binary>({}, value));
+}
@@ -179,6 +179,48 @@ TEST(BinaryUnorderedMap, Large)
     EXPECT_EQ(roundtrip_binary(v), v);
 }
 
+TEST(BinaryUnorderedMap, ReservedUpFront)
+{
+    std::unordered_map<uint64_t, uint32_t> v;
+    for (uint32_t i = 0; i < 100000; ++i) v[uint64_t(i) * 2654435761u] = i;
+    auto bytes = Serio::serialize<Serio::Binary>({}, v);
+
+    std::unordered_map<uint64_t, uint32_t> out{{1, 1}};
+    Serio::deserialize<Serio::Binary>({}, bytes, out);
+    EXPECT_EQ(out, v);
+    EXPECT_GE(out.bucket_count() * out.max_load_factor(), float(v.size()));
+}
+
+struct MapValue
+{
+    static int copies;
+    std::vector<int> data;
+    MapValue() = default;
+    MapValue(std::vector<int> data) : data(std::move(data)) {}
+    MapValue(const MapValue& other) : data(other.data) { ++copies; }
+    MapValue(MapValue&& other) noexcept : data(std::move(other.data)) { ++copies; }
+    MapValue& operator=(const MapValue&) = default;
+    bool operator==(const MapValue& o) const { return data == o.data; }
+    SERIO_REGISTER(data)
+};
+
+int MapValue::copies = 0;
+
+TEST(BinaryMap, ValuesReadInPlace)
+{
+    std::map<std::string, MapValue> ordered{{"a", {{1, 2}}}, {"b", {{3}}}, {"c", {{}}}};
+    std::unordered_map<int, MapValue> unordered{{1, {{1}}}, {2, {{2, 2}}}};
+    auto bytes = Serio::serialize<Serio::Binary>({}, ordered, unordered);
+
+    MapValue::copies = 0;
+    std::map<std::string, MapValue> orderedOut;
+    std::unordered_map<int, MapValue> unorderedOut;
+    Serio::deserialize<Serio::Binary>({}, bytes, orderedOut, unorderedOut);
+    EXPECT_EQ(orderedOut, ordered);
+    EXPECT_EQ(unorderedOut, unordered);
+    EXPECT_EQ(MapValue::copies, 0);
+}
+
 // ---- std::unordered_multimap ----
 
 TEST(BinaryUnorderedMultimap, Empty)
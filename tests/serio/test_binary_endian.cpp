@@ -0,0 +1,198 @@
+#include "common.h"
+
+static Serio::SerializeOptions big()
+{
+    Serio::SerializeOptions options;
+    options.bigEndian = true;
+    return options;
+}
+
+template <typename T>
+T big_rt(const T& value)
+{
+    return roundtrip<Serio::Binary>(value, big());
+}
+
+template <typename T>
+T big_stream_rt(const T& value, Serio::SerializeOptions options = big())
+{
+    std::stringstream stream;
+    Serio::write<Serio::Binary>(options, stream, value);
+    T out{};
+    Serio::read<Serio::Binary>({}, stream, out);
+    return out;
+}
+
+enum class Level : uint16_t
+{
+    Low = 1,
+    High = 0x0102,
+};
+
+// ---- Serio::Impl::ByteSwap ----
+
+template <typename T>
+static void checkByteSwap()
+{
+    using Serio::Impl::byteSwap;
+    for (Serio::Size count : {0, 1, 3, 7, 8, 15, 16, 33, 100})
+    {
+        std::vector<T> input(count), output(count), expected(count);
+        for (Serio::Size i = 0; i < count; ++i) input[i] = T(0x0123456789ABCDEFull * (i + 1));
+        for (Serio::Size i = 0; i < count; ++i) expected[i] = byteSwap(input[i]);
+
+        Serio::Impl::ByteSwap<sizeof(T)>::copy((char*)output.data(), (const char*)input.data(), count);
+        EXPECT_EQ(output, expected);
+        Serio::Impl::ByteSwap<sizeof(T)>::copy((char*)input.data(), (const char*)input.data(), count);
+        EXPECT_EQ(input, expected);
+    }
+}
+
+TEST(BinaryEndian, ByteSwap16) { checkByteSwap<uint16_t>(); }
+TEST(BinaryEndian, ByteSwap32) { checkByteSwap<uint32_t>(); }
+TEST(BinaryEndian, ByteSwap64) { checkByteSwap<uint64_t>(); }
+
+TEST(BinaryEndian, OrderedType)
+{
+    char data[4];
+    Serio::Impl::OrderedType<Serio::Impl::ByteOrder::Big>::serialize(data, uint32_t(0x01020304));
+    EXPECT_EQ(std::string(data, 4), std::string("\x01\x02\x03\x04", 4));
+
+    float value;
+    Serio::Impl::OrderedType<Serio::Impl::ByteOrder::Big>::serialize(data, 1.0f);
+    Serio::Impl::OrderedType<Serio::Impl::ByteOrder::Big>::deserialize(data, value);
+    EXPECT_EQ(std::string(data, 4), std::string("\x3F\x80\x00\x00", 4));
+    EXPECT_EQ(value, 1.0f);
+}
+
+// ---- SerializeOptions::bigEndian ----
+
+TEST(BinaryEndian, SetsHeaderFlag)
+{
+    auto bytes = Serio::serialize<Serio::Binary>(big(), 1);
+    EXPECT_EQ(uint8_t(bytes[2]), uint8_t(Serio::Impl::Flags::BigEndian));
+
+    auto options = big();
+    options.varint = true;
+    bytes = Serio::serialize<Serio::Binary>(options, 1);
+    EXPECT_EQ(uint8_t(bytes[2]), uint8_t(Serio::Impl::Flags::BigEndian | Serio::Impl::Flags::Varint));
+}
+
+TEST(BinaryEndian, BigEndianOnWire)
+{
+    auto bytes = Serio::serialize<Serio::Binary>(big(), uint16_t(0x0102), std::vector<uint32_t>{0x03040506}, 1.0);
+    EXPECT_EQ(bytes.substr(4), std::string("\x01\x02"
+                                           "\x00\x00\x00\x00\x00\x00\x00\x01"
+                                           "\x03\x04\x05\x06"
+                                           "\x3F\xF0\x00\x00\x00\x00\x00\x00",
+                                           22));
+}
+
+TEST(BinaryEndian, SameSizeAsLittleEndian)
+{
+    std::vector<Named> value{{"hello", 70000}, {"", -1}};
+    auto bytes = Serio::serialize<Serio::Binary>(big(), value);
+    EXPECT_EQ(bytes.size(), Serio::serialize<Serio::Binary>({}, value).size());
+    EXPECT_EQ(bytes.size(), Serio::serializedSize(big(), value));
+}
+
+TEST(BinaryEndian, Scalars)
+{
+    EXPECT_EQ(big_rt(int16_t(-2)), -2);
+    EXPECT_EQ(big_rt(std::numeric_limits<int64_t>::min()), std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(big_rt(3.5f), 3.5f);
+    EXPECT_EQ(big_rt(-1e300), -1e300);
+    EXPECT_EQ(big_rt(Level::High), Level::High);
+    EXPECT_EQ(big_rt(true), true);
+}
+
+TEST(BinaryEndian, Arrays)
+{
+    std::vector<int16_t> shorts(1001);
+    std::vector<int64_t> longs(257);
+    std::vector<double> doubles(99);
+    for (size_t i = 0; i < shorts.size(); ++i) shorts[i] = int16_t(i * 37 - 500);
+    for (size_t i = 0; i < longs.size(); ++i) longs[i] = int64_t(i) * 0x0101010101ll - 7;
+    for (size_t i = 0; i < doubles.size(); ++i) doubles[i] = i * 0.25 - 3;
+    std::vector<std::complex<float>> complex{{1, -2}, {3.5f, 4}};
+    std::vector<Level> levels{Level::Low, Level::High};
+    std::array<uint32_t, 5> array{1, 2, 3, 0xFFFFFFFF, 0x01020304};
+
+    EXPECT_EQ(big_rt(shorts), shorts);
+    EXPECT_EQ(big_rt(longs), longs);
+    EXPECT_EQ(big_rt(doubles), doubles);
+    EXPECT_EQ(big_rt(complex), complex);
+    EXPECT_EQ(big_rt(levels), levels);
+    EXPECT_EQ(big_rt(array), array);
+}
+
+TEST(BinaryEndian, Structures)
+{
+    AllBuiltins all;
+    all.i16 = -300, all.u32 = 0x01020304, all.i64 = -1ll << 40, all.f = 1.5f, all.d = -2.25;
+    std::vector<Point3D> points{{1, 2, 3}, {4, 5, 6}};
+    std::map<int32_t, std::string> map{{-5, "a"}, {1 << 20, "b"}};
+    std::tuple<int, double, std::string> tuple{7, 8.5, "nine"};
+    EXPECT_EQ(big_rt(all), all);
+    EXPECT_EQ(big_rt(points), points);
+    EXPECT_EQ(big_rt(map), map);
+    EXPECT_EQ(big_rt(tuple), tuple);
+}
+
+TEST(BinaryEndian, Stream)
+{
+    std::vector<float> large(100000);
+    for (size_t i = 0; i < large.size(); ++i) large[i] = float(i) / 3;
+    std::vector<Named> named{{"x", 1}, {"yy", -200000}};
+    EXPECT_EQ(big_stream_rt(large), large);
+    EXPECT_EQ(big_stream_rt(named), named);
+}
+
+TEST(BinaryEndian, WithVarint)
+{
+    auto options = big();
+    options.varint = true;
+    std::vector<double> doubles{1.5, -2.5};
+    std::vector<Named> named{{"x", 1}, {"yy", -2}};
+    EXPECT_EQ(roundtrip<Serio::Binary>(doubles, options), doubles);
+    EXPECT_EQ(roundtrip<Serio::Binary>(named, options), named);
+    EXPECT_EQ(big_stream_rt(doubles, options), doubles);
+}
+
+TEST(BinaryEndian, WithChecksum)
+{
+    auto options = big();
+    options.enableChecksum = true;
+    std::vector<int> value{1, 2, 3};
+    EXPECT_EQ(roundtrip<Serio::Binary>(value, options), value);
+}
+
+TEST(BinaryEndian, SerializeInto)
+{
+    std::vector<uint32_t> value{1, 2, 0x01020304};
+    auto bytes = Serio::serialize<Serio::Binary>(big(), value);
+
+    std::vector<char> memory(bytes.size());
+    auto result = Serio::serializeInto(big(), memory.data(), memory.size(), value);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(std::string(memory.data(), result.size), bytes);
+
+    Serio::Buffer buffer;
+    Serio::serializeInto(big(), buffer, value);
+    EXPECT_EQ(std::string(buffer.data(), buffer.size()), bytes);
+}
+
+TEST(BinaryEndian, Segments)
+{
+    std::vector<uint64_t> value(4096, 0x0102030405060708ull);
+    Serio::Segments segments;
+    Serio::serializeInto(big(), segments, value);
+
+    std::string bytes;
+    for (const auto& segment : segments.segments()) bytes.append(segment.data, segment.size);
+    EXPECT_EQ(bytes, Serio::serialize<Serio::Binary>(big(), value));
+
+    std::vector<uint64_t> out;
+    Serio::deserialize<Serio::Binary>({}, bytes, out);
+    EXPECT_EQ(out, value);
+}
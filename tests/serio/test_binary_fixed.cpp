@@ -0,0 +1,146 @@
+#include "common.h"
+
+enum class Side : uint8_t
+{
+    Buy,
+    Sell,
+};
+
+struct Tick
+{
+    Point3D position;
+    std::array<float, 4> weights{};
+    std::pair<int32_t, Side> order{};
+    bool operator==(const Tick& o) const
+    {
+        return position == o.position && weights == o.weights && order == o.order;
+    }
+    SERIO_REGISTER(position, weights, order)
+};
+
+// ---- Serio::Impl::WireSize ----
+
+TEST(BinaryFixed, WireSizeOfBuiltins)
+{
+    using Serio::Impl::WireSize;
+    static_assert(WireSize<int32_t>::value == 4, "");
+    static_assert(WireSize<Side>::value == 1, "");
+    static_assert(WireSize<std::array<double, 3>>::value == 24, "");
+    static_assert(WireSize<std::pair<int16_t, double>>::value == 10, "");
+    static_assert(WireSize<std::tuple<int8_t, float, uint64_t>>::value == 13, "");
+    static_assert(WireSize<std::complex<float>>::value == 8, "");
+    static_assert(WireSize<std::bitset<12>>::value == 2, "");
+    static_assert(WireSize<std::chrono::milliseconds>::value == sizeof(std::chrono::milliseconds::rep), "");
+}
+
+TEST(BinaryFixed, WireSizeOfRegistered)
+{
+    using Serio::Impl::WireSize;
+    static_assert(WireSize<Point2D>::value == 8, "");
+    static_assert(WireSize<Point3D>::value == 24, "");
+    static_assert(WireSize<AllBuiltins>::value == 43, "");
+    static_assert(WireSize<Tick>::value == 24 + 16 + 5, "");
+}
+
+TEST(BinaryFixed, WireSizeOfVariableTypes)
+{
+    using Serio::Impl::WireSize;
+    static_assert(WireSize<std::string>::value == 0, "");
+    static_assert(WireSize<std::vector<int>>::value == 0, "");
+    static_assert(WireSize<std::pair<int, std::string>>::value == 0, "");
+    static_assert(WireSize<Named>::value == 0, "");
+    static_assert(WireSize<Nested>::value == 0, "");
+    static_assert(WireSize<Vec3>::value == 0, "");
+}
+
+// ---- Hoisted bounds checks ----
+
+TEST(BinaryFixed, MatchesPerFieldLayout)
+{
+    Point3D point{1.5, -2.5, 3.25};
+    std::string expected;
+    Serio::Impl::Serializer(expected).process(point.x, point.y, point.z);
+
+    std::string bytes;
+    Serio::Impl::Serializer(bytes).process(point);
+    EXPECT_EQ(bytes, expected);
+}
+
+TEST(BinaryFixed, VectorRoundtrip)
+{
+    std::vector<Tick> ticks(1000);
+    for (size_t i = 0; i < ticks.size(); ++i)
+    {
+        double d = double(i);
+        ticks[i] = {{d, d / 2, -d}, {float(i), 1, 2, 3}, {int32_t(i), i % 2 ? Side::Sell : Side::Buy}};
+    }
+    check_bin(ticks);
+    EXPECT_EQ(Serio::serialize<Serio::Binary>({}, ticks).size(), 4 + 8 + ticks.size() * 45);
+}
+
+TEST(BinaryFixed, StreamCrossesChunks)
+{
+    std::vector<Point3D> points(100000);
+    for (size_t i = 0; i < points.size(); ++i) points[i] = {double(i), double(i) + 1, double(i) + 2};
+    EXPECT_EQ(stream_rt<Serio::Binary>(points), points);
+}
+
+TEST(BinaryFixed, OtherContainers)
+{
+    std::list<Point2D> list{{1, 2}, {3, 4}};
+    std::deque<Point2D> deque{{5, 6}, {7, 8}, {9, 10}};
+    std::forward_list<Point2D> forward{{11, 12}};
+    std::array<Point3D, 2> array{{{1, 2, 3}, {4, 5, 6}}};
+    std::vector<std::pair<int, float>> pairs{{1, 1.5f}, {2, 2.5f}};
+    std::map<int, Point2D> map{{1, {1, 1}}, {2, {2, 2}}};
+    check_bin(list);
+    check_bin(deque);
+    check_bin(forward);
+    check_bin(array);
+    check_bin(pairs);
+    check_bin(map);
+}
+
+TEST(BinaryFixed, MixedWithVariable)
+{
+    Nested nested{{1, 2}, {3, 4, 5}, "label"};
+    std::vector<std::tuple<Point2D, std::string>> tuples{{{1, 2}, "a"}, {{3, 4}, "bb"}};
+    check_bin(nested);
+    check_bin(tuples);
+}
+
+TEST(BinaryFixed, TruncatedVectorThrows)
+{
+    std::vector<Point3D> points(10, Point3D{1, 2, 3});
+    std::string bytes;
+    Serio::Impl::Serializer(bytes).process(points);
+    bytes.resize(bytes.size() - 1);
+
+    std::vector<Point3D> out;
+    EXPECT_THROW(Serio::Impl::Deserializer(bytes.data(), bytes.size(), 0).process(out), Serio::Exception);
+}
+
+TEST(BinaryFixed, TruncatedObjectThrows)
+{
+    std::string bytes;
+    Serio::Impl::Serializer(bytes).process(Tick{});
+    bytes.resize(bytes.size() - 1);
+
+    Tick out;
+    EXPECT_THROW(Serio::Impl::Deserializer(bytes.data(), bytes.size(), 0).process(out), Serio::Exception);
+}
+
+TEST(BinaryFixed, CountBeyondInputThrows)
+{
+    std::string bytes;
+    Serio::Impl::Serializer(bytes).process(Serio::Size(1000), int64_t(1), int64_t(2));
+
+    std::vector<std::pair<int64_t, int64_t>> out;
+    EXPECT_THROW(Serio::Impl::Deserializer(bytes.data(), bytes.size(), 0).process(out), Serio::Exception);
+}
+
+TEST(BinaryFixed, SerializedSize)
+{
+    std::vector<Tick> ticks(37);
+    EXPECT_EQ(Serio::serializedSize({}, ticks), Serio::serialize<Serio::Binary>({}, ticks).size());
+}
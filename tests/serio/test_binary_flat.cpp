@@ -0,0 +1,185 @@
+#include "common.h"
+
+struct FlatInner
+{
+    std::string name;
+    std::vector<int> values;
+    bool operator==(const FlatInner& o) const { return name == o.name && values == o.values; }
+    SERIO_REGISTER(name, values)
+};
+
+struct FlatMessage
+{
+    int32_t id{};
+    std::string title;
+    FlatInner inner;
+    Point2D point;
+    std::vector<FlatInner> children;
+    std::vector<Point3D> points;
+    double score{};
+    bool operator==(const FlatMessage& o) const
+    {
+        return id == o.id && title == o.title && inner == o.inner && point == o.point && children == o.children &&
+               points == o.points && score == o.score;
+    }
+    SERIO_REGISTER(id, title, inner, point, children, points, score)
+};
+
+struct FlatOld
+{
+    int32_t id{};
+    std::string title;
+    SERIO_REGISTER(id, title)
+};
+
+struct FlatNew
+{
+    int32_t id{};
+    std::string title;
+    std::vector<double> extra;
+    SERIO_REGISTER(id, title, extra)
+};
+
+static FlatMessage message()
+{
+    FlatMessage value;
+    value.id = 42;
+    value.title = "flat message";
+    value.inner = {"inner", {1, 2, 3}};
+    value.point = {1.5f, -2.5f};
+    value.children = {{"first", {}}, {"second", {4, 5}}, {"third", {6}}};
+    value.points = {{1, 2, 3}, {4, 5, 6}};
+    value.score = 0.75;
+    return value;
+}
+
+static bool inside(const void* ptr, const std::string& bytes)
+{
+    auto p = static_cast<const char*>(ptr);
+    return p >= bytes.data() && p < bytes.data() + bytes.size();
+}
+
+// ---- Type::Flat ----
+
+TEST(BinaryFlat, Roundtrip)
+{
+    auto value = message();
+    EXPECT_EQ(mem_rt<Serio::Flat>(value), value);
+    EXPECT_EQ(stream_rt<Serio::Flat>(value), value);
+    EXPECT_EQ(file_rt<Serio::Flat>(value), value);
+
+    Serio::SerializeOptions checksum;
+    checksum.enableChecksum = true;
+    EXPECT_EQ(mem_rt<Serio::Flat>(value, checksum), value);
+}
+
+TEST(BinaryFlat, SameAsBinaryWithoutTables)
+{
+    std::vector<Point3D> points{{1, 2, 3}, {4, 5, 6}};
+    auto flat = Serio::serialize<Serio::Flat>({}, points, std::string("text"));
+    auto binary = Serio::serialize<Serio::Binary>({}, points, std::string("text"));
+    EXPECT_EQ(flat.substr(4), binary.substr(4));
+}
+
+TEST(BinaryFlat, ReadsMembersInPlace)
+{
+    auto value = message();
+    auto bytes = Serio::serialize<Serio::Flat>({}, value);
+    auto view = Serio::flatView<FlatMessage>(bytes);
+
+    EXPECT_EQ(view.count(), 7u);
+    EXPECT_EQ(view.get<0>(), 42);
+    EXPECT_EQ(view.get<1>(), "flat message");
+    auto title = view.get<1, std::string_view>();
+    EXPECT_EQ(title, "flat message");
+    EXPECT_TRUE(inside(title.data(), bytes));
+    EXPECT_EQ(view.get<6>(), 0.75);
+
+    auto inner = view.get<2>();
+    EXPECT_EQ(inner.get<0>(), "inner");
+    EXPECT_EQ(inner.get<1>(), std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(inner.decode(), value.inner);
+
+    auto point = view.get<3>();
+    EXPECT_EQ(point.get<0>(), 1.5f);
+    EXPECT_EQ(point.get<1>(), -2.5f);
+    EXPECT_EQ(point.decode(), value.point);
+}
+
+TEST(BinaryFlat, ReadsVectorsOfClasses)
+{
+    auto value = message();
+    auto bytes = Serio::serialize<Serio::Flat>({}, value);
+    auto view = Serio::flatView<FlatMessage>(bytes);
+
+    auto children = view.get<4>();
+    ASSERT_EQ(children.size(), 3u);
+    EXPECT_EQ(children[1].get<0>(), "second");
+    EXPECT_EQ(children[2].get<1>(), std::vector<int>({6}));
+    std::vector<std::string> names;
+    for (auto child : children) names.push_back(child.get<0>());
+    EXPECT_EQ(names, std::vector<std::string>({"first", "second", "third"}));
+    EXPECT_THROW(children[3], Serio::Exception);
+
+    auto points = view.get<5>();
+    ASSERT_EQ(points.size(), 2u);
+    EXPECT_EQ(points[1].get<2>(), 6.0);
+    EXPECT_EQ(points[0].decode(), value.points[0]);
+}
+
+TEST(BinaryFlat, NewerDataReadsAsOlderClass)
+{
+    FlatNew value{7, "seven", {1.0, 2.0}};
+    auto bytes = Serio::serialize<Serio::Flat>({}, value, 99);
+
+    FlatOld old;
+    int tail = 0;
+    Serio::deserialize<Serio::Flat>({}, bytes, old, tail);
+    EXPECT_EQ(old.id, 7);
+    EXPECT_EQ(old.title, "seven");
+    EXPECT_EQ(tail, 99);
+
+    auto view = Serio::flatView<FlatOld>(bytes);
+    EXPECT_EQ(view.count(), 3u);
+    EXPECT_EQ(view.get<1>(), "seven");
+}
+
+TEST(BinaryFlat, OlderDataLacksNewMembers)
+{
+    FlatOld value{1, "one"};
+    auto bytes = Serio::serialize<Serio::Flat>({}, value);
+
+    auto view = Serio::flatView<FlatNew>(bytes);
+    EXPECT_TRUE(view.has<1>());
+    EXPECT_FALSE(view.has<2>());
+    EXPECT_EQ(view.get<1>(), "one");
+    EXPECT_THROW(view.get<2>(), Serio::Exception);
+
+    FlatNew out;
+    EXPECT_THROW(Serio::deserialize<Serio::Flat>({}, bytes, out), Serio::Exception);
+}
+
+TEST(BinaryFlat, RejectsOtherFormats)
+{
+    auto value = message();
+    auto flat = Serio::serialize<Serio::Flat>({}, value);
+    auto binary = Serio::serialize<Serio::Binary>({}, value);
+
+    FlatMessage out;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>({}, flat, out), Serio::Exception);
+    EXPECT_THROW(Serio::flatView<FlatMessage>(binary), Serio::Exception);
+
+    Serio::SerializeOptions varint;
+    varint.varint = true;
+    EXPECT_THROW(Serio::serialize<Serio::Flat>(varint, value), Serio::Exception);
+}
+
+TEST(BinaryFlat, TruncatedDataThrows)
+{
+    auto bytes = Serio::serialize<Serio::Flat>({}, message());
+    bytes.resize(bytes.size() / 2);
+
+    FlatMessage out;
+    EXPECT_THROW(Serio::deserialize<Serio::Flat>({}, bytes, out), Serio::Exception);
+    EXPECT_THROW(Serio::flatView<FlatMessage>(bytes), Serio::Exception);
+}
@@ -276,3 +276,28 @@ TEST(BinaryFundamental, UnsignedLongNative)
     unsigned long v = 9999999999UL;
     EXPECT_EQ(roundtrip_binary(v), v);
 }
+
+// ---- wire byte order ----
+
+TEST(BinaryFundamental, LittleEndianOnWire)
+{
+    std::string bytes;
+    Serio::Impl::Serializer(bytes).process(uint16_t(0x0102), uint32_t(0x03040506), uint64_t(0x0708090A0B0C0D0E));
+    EXPECT_EQ(bytes, std::string("\x02\x01\x06\x05\x04\x03\x0E\x0D\x0C\x0B\x0A\x09\x08\x07", 14));
+}
+
+TEST(BinaryFundamental, FloatBitsOnWire)
+{
+    std::string bytes;
+    Serio::Impl::Serializer(bytes).process(1.0f, -2.0);
+    EXPECT_EQ(bytes, std::string("\x00\x00\x80\x3F\x00\x00\x00\x00\x00\x00\x00\xC0", 12));
+}
+
+TEST(BinaryFundamental, ByteSwap)
+{
+    using Serio::Impl::byteSwap;
+    static_assert(Serio::Impl::nativeOrder() != Serio::Impl::ByteOrder::Unknown, "");
+    EXPECT_EQ(byteSwap(uint16_t(0x0102)), 0x0201);
+    EXPECT_EQ(byteSwap(uint32_t(0x01020304)), 0x04030201u);
+    EXPECT_EQ(byteSwap(uint64_t(0x0102030405060708)), 0x0807060504030201u);
+}
@@ -0,0 +1,91 @@
+#include "common.h"
+
+#if SERIO_ENABLE_PMR
+
+// Counts what is allocated through it, passing the requests on to a monotonic arena.
+struct CountingResource : std::pmr::memory_resource
+{
+    std::pmr::monotonic_buffer_resource arena;
+    Serio::Size allocations = 0;
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override
+    {
+        ++allocations;
+        return arena.allocate(bytes, align);
+    }
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t align) override
+    {
+        arena.deallocate(ptr, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+static Serio::DeserializeOptions on(std::pmr::memory_resource& resource)
+{
+    Serio::DeserializeOptions options;
+    options.memoryResource = &resource;
+    return options;
+}
+
+// ---- DeserializeOptions::memoryResource ----
+
+TEST(BinaryPmr, ReadsStandardContainersIntoPmrOnes)
+{
+    std::vector<std::string> names{"a", "long enough to leave the small string buffer"};
+    std::map<std::string, std::vector<int>> lists{{"x", {1, 2}}, {"y", {}}};
+    std::unordered_map<int, std::string> lookup{{1, "one"}, {2, "two"}};
+    std::set<std::string> tags{"first", "second"};
+    auto bytes = Serio::serialize<Serio::Binary>({}, names, lists, lookup, tags);
+
+    CountingResource resource;
+    std::pmr::vector<std::pmr::string> pmrNames(&resource);
+    std::pmr::map<std::pmr::string, std::pmr::vector<int>> pmrLists(&resource);
+    std::pmr::unordered_map<int, std::pmr::string> pmrLookup(&resource);
+    std::pmr::set<std::pmr::string> pmrTags(&resource);
+    Serio::deserialize<Serio::Binary>(on(resource), bytes, pmrNames, pmrLists, pmrLookup, pmrTags);
+
+    ASSERT_EQ(pmrNames.size(), 2u);
+    EXPECT_EQ(std::string_view(pmrNames[1]), names[1]);
+    EXPECT_EQ(pmrNames[1].get_allocator().resource(), &resource);
+    EXPECT_EQ(pmrLists.at("x"), std::pmr::vector<int>({1, 2}));
+    for (const auto& item : pmrLists) EXPECT_EQ(item.first.get_allocator().resource(), &resource);
+    EXPECT_EQ(pmrLookup.at(2), "two");
+    EXPECT_EQ(pmrTags.count("second"), 1u);
+    EXPECT_GT(resource.allocations, 0u);
+
+    std::pmr::vector<std::pmr::string> heapNames;
+    Serio::deserialize<Serio::Binary>({}, bytes, heapNames);
+    EXPECT_EQ(heapNames[1].get_allocator().resource(), std::pmr::get_default_resource());
+}
+
+TEST(BinaryPmr, SharedPointeesComeFromResource)
+{
+    auto named = std::make_shared<Named>(Named{"shared", 7});
+    auto text = std::make_shared<std::string>("text long enough to leave the small string buffer");
+    auto bytes = Serio::serialize<Serio::Binary>({}, named, text);
+
+    CountingResource resource;
+    std::shared_ptr<Named> outNamed;
+    std::shared_ptr<std::pmr::string> outText;
+    Serio::deserialize<Serio::Binary>(on(resource), bytes, outNamed, outText);
+    EXPECT_EQ(*outNamed, *named);
+    EXPECT_EQ(std::string_view(*outText), *text);
+    EXPECT_EQ(outText->get_allocator().resource(), &resource);
+    EXPECT_GE(resource.allocations, 3u);
+}
+
+TEST(BinaryPmr, OptionalsAndStreams)
+{
+    std::optional<std::string> note = std::string(64, 'n');
+    std::stringstream stream;
+    Serio::write<Serio::Binary>({}, stream, note);
+
+    CountingResource resource;
+    std::optional<std::pmr::string> out;
+    Serio::read<Serio::Binary>(on(resource), stream, out);
+    ASSERT_TRUE(out);
+    EXPECT_EQ(std::string_view(*out), *note);
+    EXPECT_EQ(out->get_allocator().resource(), &resource);
+}
+
+#endif
@@ -0,0 +1,174 @@
+#include "common.h"
+
+struct Shape
+{
+    std::string name;
+    virtual ~Shape() = default;
+    virtual double area() const = 0;
+    SERIO_REGISTER(name)
+};
+
+struct Circle : Shape
+{
+    double radius = 0;
+    Circle() = default;
+    Circle(std::string name, double radius) : radius(radius) { this->name = std::move(name); }
+    double area() const override { return 3 * radius * radius; }
+    SERIO_REGISTER(name, radius)
+};
+
+struct Square : Shape
+{
+    double side = 0;
+    Square() = default;
+    Square(std::string name, double side) : side(side) { this->name = std::move(name); }
+    double area() const override { return side * side; }
+    SERIO_REGISTER(name, side)
+};
+
+struct Ring : Circle
+{
+    double inner = 0;
+    Ring() = default;
+    Ring(std::string name, double radius, double inner) : Circle(std::move(name), radius), inner(inner) {}
+    double area() const override { return Circle::area() - 3 * inner * inner; }
+    SERIO_REGISTER(name, radius, inner)
+};
+
+struct Triangle : Shape
+{
+    double area() const override { return 0; }
+};
+
+SERIO_POLYMORPHIC(Shape, Circle, Square, Ring)
+
+struct Layer
+{
+    std::vector<std::unique_ptr<Shape>> owned;
+    std::vector<std::shared_ptr<const Shape>> shared;
+    SERIO_REGISTER(owned, shared)
+};
+
+struct Animal
+{
+    int legs = 0;
+    virtual ~Animal() = default;
+    SERIO_REGISTER(legs)
+};
+
+struct Pet : virtual Animal
+{
+    std::string owner;
+    SERIO_REGISTER(legs, owner)
+};
+
+SERIO_POLYMORPHIC(Animal, Animal, Pet)
+
+static std::vector<Serio::SerializeOptions> encodings()
+{
+    std::vector<Serio::SerializeOptions> options(4);
+    options[1].varint = true;
+    options[2].bigEndian = options[2].trackPointers = true;
+    options[3].varint = options[3].presize = options[3].trackPointers = true;
+    return options;
+}
+
+static Layer layer()
+{
+    Layer value;
+    value.owned.emplace_back(new Circle("circle", 2));
+    value.owned.emplace_back(new Square("square", 3));
+    value.owned.emplace_back();
+    value.owned.emplace_back(new Ring("ring", 4, 1));
+    auto shared = std::make_shared<Square>("shared", 5);
+    value.shared = {shared, std::make_shared<Ring>("other", 2, 1), shared};
+    return value;
+}
+
+// ---- SERIO_POLYMORPHIC ----
+
+TEST(BinaryPolymorphic, DerivedClassesRestored)
+{
+    auto value = layer();
+    for (const auto& options : encodings())
+    {
+        auto bytes = Serio::serialize<Serio::Binary>(options, value);
+        Layer out;
+        Serio::deserialize<Serio::Binary>({}, bytes, out);
+
+        ASSERT_EQ(out.owned.size(), 4u);
+        auto circle = dynamic_cast<Circle*>(out.owned[0].get());
+        auto square = dynamic_cast<Square*>(out.owned[1].get());
+        auto ring = dynamic_cast<Ring*>(out.owned[3].get());
+        ASSERT_TRUE(circle && square && ring);
+        EXPECT_EQ(circle->name, "circle");
+        EXPECT_EQ(circle->radius, 2);
+        EXPECT_EQ(square->side, 3);
+        EXPECT_FALSE(out.owned[2]);
+        EXPECT_EQ(ring->inner, 1);
+        EXPECT_EQ(ring->area(), value.owned[3]->area());
+
+        ASSERT_EQ(out.shared.size(), 3u);
+        EXPECT_EQ(dynamic_cast<const Square&>(*out.shared[0]).side, 5);
+        EXPECT_EQ(dynamic_cast<const Ring&>(*out.shared[1]).name, "other");
+        EXPECT_EQ(out.shared[0] == out.shared[2], options.trackPointers);
+    }
+}
+
+TEST(BinaryPolymorphic, FromStream)
+{
+    std::stringstream stream;
+    Serio::write<Serio::Binary>({}, stream, layer(), std::string("tail"));
+
+    Layer out;
+    std::string tail;
+    Serio::read<Serio::Binary>({}, stream, out, tail);
+    EXPECT_EQ(out.owned[3]->area(), layer().owned[3]->area());
+    EXPECT_EQ(tail, "tail");
+}
+
+TEST(BinaryPolymorphic, VirtualBase)
+{
+    std::unique_ptr<Animal> animal(new Animal), pet(new Pet);
+    animal->legs = 2;
+    pet->legs = 4;
+    dynamic_cast<Pet&>(*pet).owner = "someone";
+    auto bytes = Serio::serialize<Serio::Binary>({}, animal, pet);
+
+    std::unique_ptr<Animal> outAnimal, outPet;
+    Serio::deserialize<Serio::Binary>({}, bytes, outAnimal, outPet);
+    EXPECT_EQ(typeid(*outAnimal), typeid(Animal));
+    EXPECT_EQ(outAnimal->legs, 2);
+    ASSERT_EQ(typeid(*outPet), typeid(Pet));
+    EXPECT_EQ(outPet->legs, 4);
+    EXPECT_EQ(dynamic_cast<Pet&>(*outPet).owner, "someone");
+}
+
+TEST(BinaryPolymorphic, Skipped)
+{
+    for (const auto& options : encodings())
+    {
+        auto bytes = Serio::serialize<Serio::Binary>(options, layer(), 11);
+        int tail = 0;
+        Serio::deserialize<Serio::Binary>({}, bytes, Serio::skip<Layer>(), tail);
+        EXPECT_EQ(tail, 11);
+    }
+}
+
+TEST(BinaryPolymorphic, UnlistedClassThrows)
+{
+    std::unique_ptr<Shape> shape(new Triangle);
+    EXPECT_THROW(Serio::serialize<Serio::Binary>({}, shape), Serio::Exception);
+}
+
+TEST(BinaryPolymorphic, InvalidIdThrows)
+{
+    std::unique_ptr<Shape> shape(new Circle("circle", 1));
+    auto bytes = Serio::serialize<Serio::Binary>({}, shape);
+    bytes[5] = 9;
+
+    std::unique_ptr<Shape> out;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>({}, bytes, out), Serio::Exception);
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>({}, bytes, Serio::skip<std::unique_ptr<Shape>>()),
+                 Serio::Exception);
+}
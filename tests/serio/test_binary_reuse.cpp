@@ -0,0 +1,102 @@
+#include "common.h"
+
+struct Message
+{
+    std::map<int, std::string> fields;
+    std::unordered_map<std::string, std::vector<int>> lists;
+    std::set<std::string> tags;
+    std::unique_ptr<Named> owner;
+    std::optional<std::string> note;
+    bool operator==(const Message& o) const
+    {
+        bool owners = owner ? o.owner && *owner == *o.owner : !o.owner;
+        return fields == o.fields && lists == o.lists && tags == o.tags && owners && note == o.note;
+    }
+    SERIO_REGISTER(fields, lists, tags, owner, note)
+};
+
+static Message message(int seed, int count)
+{
+    Message value;
+    for (int i = 0; i < count; ++i)
+    {
+        value.fields[i * seed] = std::string(i + 20, char('a' + i % 26));
+        value.lists[std::to_string(i + seed)] = std::vector<int>(i, seed);
+        value.tags.insert("tag" + std::to_string(i * seed));
+    }
+    value.owner.reset(new Named{"owner" + std::to_string(seed), seed});
+    value.note = std::string(40, char('A' + seed % 26));
+    return value;
+}
+
+static Serio::DeserializeOptions reusing()
+{
+    Serio::DeserializeOptions options;
+    options.reuse = true;
+    return options;
+}
+
+// ---- DeserializeOptions::reuse ----
+
+TEST(BinaryReuse, DecodesSameValues)
+{
+    Message out;
+    for (int count : {5, 8, 0, 3, 8})
+    {
+        auto value = message(count + 1, count);
+        auto bytes = Serio::serialize<Serio::Binary>({}, value);
+        Serio::deserialize<Serio::Binary>(reusing(), bytes, out);
+        EXPECT_EQ(out, value);
+    }
+
+    auto bytes = Serio::serialize<Serio::Binary>({}, Message());
+    Serio::deserialize<Serio::Binary>(reusing(), bytes, out);
+    EXPECT_EQ(out, Message());
+}
+
+TEST(BinaryReuse, RecyclesNodes)
+{
+    auto first = Serio::serialize<Serio::Binary>({}, message(1, 10));
+    auto second = message(3, 10);
+    auto bytes = Serio::serialize<Serio::Binary>({}, second);
+
+    Message out;
+    Serio::deserialize<Serio::Binary>(reusing(), first, out);
+    std::set<const void*> nodes;
+    for (const auto& item : out.fields) nodes.insert(&item.second);
+    for (const auto& item : out.lists) nodes.insert(&item.second);
+    for (const auto& item : out.tags) nodes.insert(&item);
+    const Named* owner = out.owner.get();
+    const char* note = out.note->data();
+
+    Serio::deserialize<Serio::Binary>(reusing(), bytes, out);
+    EXPECT_EQ(out, second);
+    for (const auto& item : out.fields) EXPECT_TRUE(nodes.count(&item.second));
+    for (const auto& item : out.lists) EXPECT_TRUE(nodes.count(&item.second));
+    for (const auto& item : out.tags) EXPECT_TRUE(nodes.count(&item));
+    EXPECT_EQ(out.owner.get(), owner);
+    EXPECT_EQ(out.note->data(), note);
+}
+
+TEST(BinaryReuse, FromStream)
+{
+    std::stringstream stream;
+    for (int i = 1; i <= 3; ++i) Serio::write<Serio::Binary>({}, stream, message(i, 4 * i));
+
+    Message out;
+    for (int i = 1; i <= 3; ++i)
+    {
+        Serio::read<Serio::Binary>(reusing(), stream, out);
+        EXPECT_EQ(out, message(i, 4 * i));
+    }
+}
+
+TEST(BinaryReuse, OffReplacesEverything)
+{
+    auto bytes = Serio::serialize<Serio::Binary>({}, message(2, 4));
+    Message out = message(1, 4);
+    const Named* owner = out.owner.get();
+    Serio::deserialize<Serio::Binary>({}, bytes, out);
+    EXPECT_EQ(out, message(2, 4));
+    EXPECT_NE(out.owner.get(), owner);
+}
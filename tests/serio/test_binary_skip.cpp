@@ -0,0 +1,176 @@
+#include "common.h"
+
+struct Counted
+{
+    static int created;
+    std::string name;
+    std::vector<double> values;
+    Counted() { ++created; }
+    Counted(std::string name, std::vector<double> values) : name(std::move(name)), values(std::move(values)) {}
+    SERIO_REGISTER(name, values)
+};
+
+int Counted::created = 0;
+
+struct Labeled
+{
+    int id = 0;
+    std::string blob;
+    std::vector<Named> items;
+    SERIO_REGISTER(Serio::nvp("id", id), Serio::binaryString(blob), Serio::nvp("items", items))
+};
+
+static std::vector<Serio::SerializeOptions> encodings()
+{
+    std::vector<Serio::SerializeOptions> options(4);
+    options[1].varint = true;
+    options[2].bigEndian = true;
+    options[3].varint = options[3].bigEndian = true;
+    return options;
+}
+
+// Skips a value of `T` in front of a sentinel, from memory and from a stream, under every encoding.
+template <typename T>
+static void expect_skipped(const T& value)
+{
+    for (const auto& options : encodings())
+    {
+        auto bytes = Serio::serialize<Serio::Binary>(options, value, 0x5EA1);
+        int tail = 0;
+        Serio::deserialize<Serio::Binary>({}, bytes, Serio::skip<T>(), tail);
+        EXPECT_EQ(tail, 0x5EA1);
+
+        std::stringstream stream;
+        Serio::write<Serio::Binary>(options, stream, value, 0x5EA1);
+        tail = 0;
+        Serio::read<Serio::Binary>({}, stream, Serio::skip<T>(), tail);
+        EXPECT_EQ(tail, 0x5EA1);
+    }
+}
+
+// ---- Serio::skip ----
+
+TEST(BinarySkip, Scalars)
+{
+    expect_skipped(true);
+    expect_skipped(int8_t(-5));
+    expect_skipped(int64_t(-123456789012));
+    expect_skipped(uint32_t(300));
+    expect_skipped(3.25);
+    expect_skipped(std::complex<float>(1, 2));
+    expect_skipped(std::chrono::milliseconds(1500));
+    expect_skipped(std::bitset<13>(0x1ABC));
+}
+
+TEST(BinarySkip, StringsAndContainers)
+{
+    expect_skipped(std::string("hello world"));
+    expect_skipped(std::u16string(u"wide"));
+    expect_skipped(std::vector<int>{1, -2, 300, 40000});
+    expect_skipped(std::vector<double>{1.5, 2.5});
+    expect_skipped(std::vector<std::string>{"a", "", "ccc"});
+    expect_skipped(std::vector<bool>{true, false, true, true, false, true, false, false, true});
+    expect_skipped(std::list<Point3D>{{1, 2, 3}, {4, 5, 6}});
+    expect_skipped(std::deque<Named>{{"one", 1}, {"two", 2}});
+    expect_skipped(std::set<int>{3, 1, 2});
+    expect_skipped(std::map<std::string, std::vector<int>>{{"a", {1}}, {"b", {2, 3}}});
+    expect_skipped(std::unordered_map<int, Point2D>{{1, {1, 2}}, {2, {3, 4}}});
+    expect_skipped(std::array<int, 4>{1, 2, 3, 4});
+    expect_skipped(std::array<std::string, 2>{"x", "yy"});
+    expect_skipped(std::queue<int>(std::deque<int>{1, 2, 3}));
+}
+
+TEST(BinarySkip, CompositeTypes)
+{
+    expect_skipped(std::make_pair(std::string("key"), 42));
+    expect_skipped(std::make_tuple(1, std::string("two"), 3.0));
+    expect_skipped(Nested{{1, 2}, {3, 4, 5}, "label"});
+    expect_skipped(AllBuiltins{true, -1, 2, -3, 4, -5, 6, -7, 8, 9.5f, 10.5});
+    expect_skipped(Vec3{1, 2, 3});
+    expect_skipped(IntBag({1, 2, 3}));
+    expect_skipped(std::make_shared<Named>(Named{"shared", 1}));
+    expect_skipped(std::shared_ptr<Named>());
+    expect_skipped(std::unique_ptr<std::string>(new std::string("unique")));
+    expect_skipped(std::optional<std::string>("set"));
+    expect_skipped(std::optional<std::string>());
+    expect_skipped(std::variant<int, std::string, Nested>(std::string("alternative")));
+    expect_skipped(std::variant<int, std::string, Nested>(Nested{{1, 2}, {3}, "n"}));
+}
+
+TEST(BinarySkip, NamedAndBinaryMembers)
+{
+    expect_skipped(Labeled{7, std::string("\0\x01\xFF", 3), {{"x", 1}, {"yy", 2}}});
+    expect_skipped(std::vector<Labeled>(3));
+}
+
+TEST(BinarySkip, ReadsValueAfterSkippedOnes)
+{
+    std::vector<Named> records{{"first", 1}, {"second", 2}};
+    std::map<int, std::string> lookup{{1, "one"}, {2, "two"}};
+    auto bytes = Serio::serialize<Serio::Binary>({}, std::string("header"), records, lookup, Point3D{1, 2, 3});
+
+    Point3D point;
+    Serio::deserialize<Serio::Binary>({}, bytes, Serio::skip<std::string>(), Serio::skip<std::vector<Named>>(),
+                                      Serio::skip<std::map<int, std::string>>(), point);
+    EXPECT_EQ(point, (Point3D{1, 2, 3}));
+}
+
+TEST(BinarySkip, ConstructsNothing)
+{
+    std::vector<Counted> values(1000, Counted("value", {1, 2, 3}));
+    auto bytes = Serio::serialize<Serio::Binary>({}, values, std::string("end"));
+
+    Counted::created = 0;
+    std::string tail;
+    Serio::deserialize<Serio::Binary>({}, bytes, Serio::skip<std::vector<Counted>>(), tail);
+    EXPECT_EQ(tail, "end");
+    EXPECT_EQ(Counted::created, 0);
+}
+
+TEST(BinarySkip, LargeValuesInStream)
+{
+    std::string large(3 << 20, 'x');
+    std::vector<float> samples(1 << 18, 0.5f);
+    std::stringstream stream;
+    Serio::write<Serio::Binary>({}, stream, large, samples, std::string("tail"));
+
+    Serio::DeserializeOptions options;
+    options.streamBuffer = 4096;
+    std::string tail;
+    Serio::read<Serio::Binary>(options, stream, Serio::skip<std::string>(), Serio::skip<std::vector<float>>(), tail);
+    EXPECT_EQ(tail, "tail");
+}
+
+TEST(BinarySkip, IndexedVector)
+{
+    std::vector<Named> values{{"a", 1}, {"bb", 2}, {"ccc", 3}};
+    for (const auto& options : encodings())
+    {
+        auto bytes = Serio::serialize<Serio::Binary>(options, Serio::indexed(values), 9);
+        int tail = 0;
+        Serio::deserialize<Serio::Binary>({}, bytes, Serio::skip<Serio::IndexedView<Named>>(), tail);
+        EXPECT_EQ(tail, 9);
+    }
+}
+
+TEST(BinarySkip, FlatTables)
+{
+    Nested value{{1, 2}, {3, 4, 5}, "label"};
+    auto bytes = Serio::serialize<Serio::Flat>({}, value, std::vector<Named>{{"a", 1}}, 7);
+    int tail = 0;
+    Serio::deserialize<Serio::Flat>({}, bytes, Serio::skip<Nested>(), Serio::skip<std::vector<Named>>(), tail);
+    EXPECT_EQ(tail, 7);
+}
+
+TEST(BinarySkip, TruncatedDataThrows)
+{
+    auto bytes = Serio::serialize<Serio::Binary>({}, std::vector<std::string>{"abc", "defgh"});
+    bytes.resize(bytes.size() - 2);
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>({}, bytes, Serio::skip<std::vector<std::string>>()),
+                 Serio::Exception);
+
+    auto large = Serio::serialize<Serio::Binary>({}, std::vector<int>(10, 1));
+    Serio::DeserializeOptions limit;
+    limit.maxLength = 5;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>(limit, large, Serio::skip<std::vector<int>>()), Serio::Exception);
+}
@@ -0,0 +1,511 @@
+#include "common.h"
+
+// Counts the block writes that reach the stream buffer.
+struct CountingBuf : std::stringbuf
+{
+    int calls = 0;
+
+protected:
+    std::streamsize xsputn(const char* data, std::streamsize size) override
+    {
+        ++calls;
+        return std::stringbuf::xsputn(data, size);
+    }
+};
+
+static Serio::SerializeOptions buffered(Serio::Size size)
+{
+    Serio::SerializeOptions options;
+    options.streamBuffer = size;
+    return options;
+}
+
+template <typename T>
+static std::string written(const T& value, Serio::SerializeOptions options = {})
+{
+    std::stringstream stream;
+    Serio::write<Serio::Binary>(options, stream, value);
+    return stream.str();
+}
+
+// ---- SerializeOptions::streamBuffer ----
+
+TEST(BinaryStream, SameBytesAsSerialize)
+{
+    std::vector<Named> named{{"alpha", 1}, {"", -2}, {std::string(300, 'x'), 3}};
+    std::vector<double> doubles(5000, 1.25);
+    std::map<int, std::string> map{{1, "a"}, {2, "b"}};
+    for (Serio::Size size : {0, 16, 100, 4096, 1 << 16})
+    {
+        EXPECT_EQ(written(named, buffered(size)), Serio::serialize<Serio::Binary>({}, named));
+        EXPECT_EQ(written(doubles, buffered(size)), Serio::serialize<Serio::Binary>({}, doubles));
+        EXPECT_EQ(written(map, buffered(size)), Serio::serialize<Serio::Binary>({}, map));
+    }
+}
+
+TEST(BinaryStream, FixedAndSwappedChunks)
+{
+    std::vector<Point3D> points(1000);
+    for (size_t i = 0; i < points.size(); ++i) points[i] = {double(i), -double(i), double(i * i)};
+    std::vector<uint32_t> numbers(777, 0x01020304);
+    std::bitset<300> bits;
+    bits.set(7).set(299);
+
+    auto options = buffered(64);
+    EXPECT_EQ(written(points, options), Serio::serialize<Serio::Binary>({}, points));
+    EXPECT_EQ(written(bits, options), Serio::serialize<Serio::Binary>({}, bits));
+    options.bigEndian = true;
+    EXPECT_EQ(written(numbers, options), Serio::serialize<Serio::Binary>(options, numbers));
+}
+
+TEST(BinaryStream, CombinesSmallWrites)
+{
+    std::vector<Named> named(1000, Named{"name", 42});
+    CountingBuf buf;
+    std::ostream stream(&buf);
+    Serio::write<Serio::Binary>({}, stream, named);
+    EXPECT_LE(buf.calls, 3);
+    EXPECT_EQ(buf.str(), Serio::serialize<Serio::Binary>({}, named));
+}
+
+TEST(BinaryStream, LargeBlocksBypassBuffer)
+{
+    std::string large(100000, 'z');
+    CountingBuf buf;
+    std::ostream stream(&buf);
+    Serio::write<Serio::Binary>(buffered(1024), stream, int32_t(7), large);
+    EXPECT_LE(buf.calls, 3);
+    EXPECT_EQ(buf.str(), Serio::serialize<Serio::Binary>({}, int32_t(7), large));
+}
+
+TEST(BinaryStream, SerializerFlushesOnDestruction)
+{
+    std::stringstream stream;
+    {
+        Serio::Impl::StreamSerializer serializer(stream);
+        serializer << int32_t(5) << std::string("abc");
+        EXPECT_TRUE(stream.str().empty());
+    }
+    EXPECT_EQ(stream.str(), Serio::serialize<Serio::Binary>({}, int32_t(5), std::string("abc")).substr(4));
+}
+
+// ---- DeserializeOptions::streamBuffer ----
+
+// Counts the block reads that reach the stream buffer.
+struct CountingReadBuf : std::stringbuf
+{
+    int calls = 0;
+
+    CountingReadBuf(const std::string& data) : std::stringbuf(data) {}
+
+protected:
+    std::streamsize xsgetn(char* data, std::streamsize size) override
+    {
+        ++calls;
+        return std::stringbuf::xsgetn(data, size);
+    }
+};
+
+// Serves a string in small chunks and can't seek, like a pipe.
+struct PipeBuf : std::streambuf
+{
+    std::string data;
+    Serio::Size offset = 0;
+    char chunk[7];
+
+    PipeBuf(const std::string& data) : data(data) {}
+
+protected:
+    int_type underflow() override
+    {
+        if (offset == data.size()) return traits_type::eof();
+        Serio::Size size = std::min(sizeof(chunk), data.size() - offset);
+        std::memcpy(chunk, data.data() + offset, size);
+        offset += size;
+        setg(chunk, chunk, chunk + size);
+        return traits_type::to_int_type(chunk[0]);
+    }
+};
+
+static Serio::DeserializeOptions window(Serio::Size size)
+{
+    Serio::DeserializeOptions options;
+    options.streamBuffer = size;
+    return options;
+}
+
+template <typename T>
+static T read_back(const std::string& bytes, Serio::DeserializeOptions options = {})
+{
+    std::stringstream stream(bytes);
+    T out{};
+    Serio::read<Serio::Binary>(options, stream, out);
+    return out;
+}
+
+TEST(BinaryStream, ReadsThroughWindow)
+{
+    std::vector<Named> named{{"alpha", 1}, {"", -2}, {std::string(300, 'x'), 3}};
+    std::vector<double> doubles(5000, 1.25);
+    std::vector<Point3D> points(1000, Point3D{1, 2, 3});
+    std::bitset<300> bits;
+    bits.set(7).set(299);
+    for (Serio::Size size : {0, 16, 100, 4096, 1 << 18})
+    {
+        EXPECT_EQ(read_back<std::vector<Named>>(written(named), window(size)), named);
+        EXPECT_EQ(read_back<std::vector<double>>(written(doubles), window(size)), doubles);
+        EXPECT_EQ(read_back<std::vector<Point3D>>(written(points), window(size)), points);
+        EXPECT_EQ(read_back<std::bitset<300>>(written(bits), window(size)), bits);
+    }
+}
+
+TEST(BinaryStream, ReadsVarintsThroughWindow)
+{
+    Serio::SerializeOptions options;
+    options.varint = true;
+    std::vector<Named> named(100, Named{"n", -70000});
+    std::map<int64_t, int> map{{-1, 1}, {1ll << 40, 2}};
+    EXPECT_EQ(read_back<std::vector<Named>>(written(named, options), window(16)), named);
+    EXPECT_EQ(read_back<std::vector<Named>>(written(named, options)), named);
+    EXPECT_EQ(read_back<decltype(map)>(written(map, options)), map);
+}
+
+TEST(BinaryStream, CombinesSmallReads)
+{
+    std::vector<Named> named(1000, Named{"name", 42});
+    CountingReadBuf buf(written(named));
+    std::istream stream(&buf);
+    std::vector<Named> out;
+    Serio::read<Serio::Binary>({}, stream, out);
+    EXPECT_EQ(out, named);
+    EXPECT_LE(buf.calls, 3);
+}
+
+TEST(BinaryStream, LeavesFollowingBytesInStream)
+{
+    std::stringstream stream;
+    Serio::write<Serio::Binary>({}, stream, int32_t(5), std::string("abc"));
+    stream << "tail";
+
+    int32_t number;
+    std::string text, tail;
+    Serio::read<Serio::Binary>({}, stream, number, text);
+    stream >> tail;
+    EXPECT_EQ(number, 5);
+    EXPECT_EQ(text, "abc");
+    EXPECT_EQ(tail, "tail");
+}
+
+TEST(BinaryStream, LeavesFollowingBytesInPipe)
+{
+    std::vector<Named> named(50, Named{"name", 42});
+    PipeBuf buf(written(named) + "tail");
+    std::istream stream(&buf);
+
+    std::vector<Named> out;
+    std::string tail;
+    Serio::read<Serio::Binary>({}, stream, out);
+    stream >> tail;
+    EXPECT_EQ(out, named);
+    EXPECT_EQ(tail, "tail");
+}
+
+TEST(BinaryStream, ConsecutiveDeserializers)
+{
+    std::stringstream stream;
+    Serio::Impl::StreamSerializer(stream) << int16_t(1) << std::string("two") << 3.0;
+
+    int16_t first;
+    std::string second;
+    double third;
+    Serio::Impl::StreamDeserializer(stream, 0) >> first;
+    Serio::Impl::StreamDeserializer(stream, 0) >> second;
+    Serio::Impl::StreamDeserializer(stream, 0) >> third;
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(second, "two");
+    EXPECT_EQ(third, 3.0);
+}
+
+TEST(BinaryStream, TruncatedInputThrows)
+{
+    auto bytes = written(std::vector<int64_t>(100, 7));
+    bytes.resize(bytes.size() - 3);
+    EXPECT_THROW(read_back<std::vector<int64_t>>(bytes, window(64)), Serio::Exception);
+    EXPECT_THROW(read_back<std::vector<int64_t>>(bytes), Serio::Exception);
+}
+
+// ---- DeserializeOptions::prefetch ----
+
+static Serio::DeserializeOptions prefetched(Serio::Size blocks, Serio::Size size)
+{
+    Serio::DeserializeOptions options;
+    options.prefetch = blocks;
+    options.streamBuffer = size;
+    return options;
+}
+
+TEST(BinaryStream, PrefetchBufferRotatesBlocks)
+{
+    std::string data(100003, 0);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = char(i * 7);
+    for (Serio::Size blocks : {1, 2, 5})
+    {
+        std::stringbuf source(data);
+        Serio::Impl::PrefetchBuffer buffer(&source, 1000, blocks);
+        std::istream stream(&buffer);
+        std::string out((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(out, data);
+    }
+}
+
+TEST(BinaryStream, ReadsWithPrefetch)
+{
+    std::vector<Named> named(3000, Named{"name", -5});
+    std::vector<double> doubles(50000, 2.5);
+    std::stringstream stream;
+    Serio::write<Serio::Binary>({}, stream, named, doubles);
+
+    std::vector<Named> first;
+    std::vector<double> second;
+    Serio::read<Serio::Binary>(prefetched(3, 4096), stream, first, second);
+    EXPECT_EQ(first, named);
+    EXPECT_EQ(second, doubles);
+}
+
+TEST(BinaryStream, PrefetchGivesBackFollowingBytes)
+{
+    std::stringstream stream;
+    Serio::write<Serio::Binary>({}, stream, std::string("abc"));
+    Serio::write<Serio::Binary>({}, stream, std::vector<int>(5000, 9));
+
+    std::string text;
+    std::vector<int> numbers;
+    Serio::read<Serio::Binary>(prefetched(2, 256), stream, text);
+    Serio::read<Serio::Binary>(prefetched(2, 256), stream, numbers);
+    EXPECT_EQ(text, "abc");
+    EXPECT_EQ(numbers, std::vector<int>(5000, 9));
+}
+
+TEST(BinaryStream, LoadsWithPrefetch)
+{
+    std::vector<Point3D> points(20000, Point3D{1, 2, 3});
+    std::map<std::string, int> map{{"a", 1}, {"b", 2}};
+    Serio::save<Serio::Binary>({}, TMP_FILE, points, map);
+
+    std::vector<Point3D> first;
+    std::map<std::string, int> second;
+    Serio::load<Serio::Binary>(prefetched(4, 1 << 12), TMP_FILE, first, second);
+    EXPECT_EQ(first, points);
+    EXPECT_EQ(second, map);
+}
+
+TEST(BinaryStream, LoadWithPrefetchFallsBackForChecksum)
+{
+    Serio::SerializeOptions options;
+    options.enableChecksum = true;
+    std::vector<int> value(1000, 4);
+    Serio::save<Serio::Binary>(options, TMP_FILE, value);
+
+    std::vector<int> out;
+    Serio::load<Serio::Binary>(prefetched(2, 64), TMP_FILE, out);
+    EXPECT_EQ(out, value);
+}
+
+// ---- File descriptors ----
+
+#ifdef SERIO_UNIX
+// Reads the whole file at `path` back.
+static std::string file_bytes(const char* path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+}
+
+TEST(BinaryStream, WritesAndReadsFileDescriptor)
+{
+    std::vector<Named> named{{"alpha", 1}, {"", -2}, {std::string(300, 'x'), 3}};
+    std::vector<double> doubles(50000, 1.25);
+    for (bool varint : {false, true})
+    {
+        Serio::SerializeOptions options = buffered(100);
+        options.varint = varint;
+        options.presize = true;
+        int fd = ::open(TMP_FILE, O_RDWR | O_CREAT | O_TRUNC, 0666);
+        ASSERT_NE(fd, -1);
+        Serio::write<Serio::Binary>(options, fd, named, doubles);
+        EXPECT_EQ(file_bytes(TMP_FILE), Serio::serialize<Serio::Binary>(options, named, doubles));
+
+        std::vector<Named> first;
+        std::vector<double> second;
+        lseek(fd, 0, SEEK_SET);
+        Serio::read<Serio::Binary>(window(64), fd, first, second);
+        EXPECT_EQ(first, named);
+        EXPECT_EQ(second, doubles);
+        close(fd);
+    }
+}
+
+TEST(BinaryStream, FileDescriptorGivesBackFollowingBytes)
+{
+    auto bytes = written(std::vector<int>(1000, 3)) + "tail";
+    int fd = ::open(TMP_FILE, O_RDWR | O_CREAT | O_TRUNC, 0666);
+    ASSERT_NE(fd, -1);
+    ASSERT_EQ(::write(fd, bytes.data(), bytes.size()), ssize_t(bytes.size()));
+    lseek(fd, 0, SEEK_SET);
+
+    std::vector<int> out;
+    char tail[5] = {0};
+    Serio::read<Serio::Binary>({}, fd, out);
+    EXPECT_EQ(::read(fd, tail, 4), 4);
+    EXPECT_EQ(out, std::vector<int>(1000, 3));
+    EXPECT_STREQ(tail, "tail");
+    close(fd);
+}
+
+TEST(BinaryStream, ReadsFromPipe)
+{
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::vector<Named> named(500, Named{"name", 42});
+    std::thread writer([&] {
+        Serio::write<Serio::Binary>(buffered(64), fds[1], named);
+        close(fds[1]);
+    });
+
+    std::vector<Named> out;
+    Serio::read<Serio::Binary>(window(32), fds[0], out);
+    writer.join();
+    close(fds[0]);
+    EXPECT_EQ(out, named);
+}
+
+TEST(BinaryStream, TruncatedFileDescriptorThrows)
+{
+    auto bytes = written(std::vector<int64_t>(100, 7));
+    bytes.resize(bytes.size() - 3);
+    int fd = ::open(TMP_FILE, O_RDWR | O_CREAT | O_TRUNC, 0666);
+    ASSERT_NE(fd, -1);
+    ASSERT_EQ(::write(fd, bytes.data(), bytes.size()), ssize_t(bytes.size()));
+    lseek(fd, 0, SEEK_SET);
+
+    std::vector<int64_t> out;
+    EXPECT_THROW(Serio::read<Serio::Binary>({}, fd, out), Serio::Exception);
+    close(fd);
+}
+
+TEST(BinaryStream, SavesWithDirectIO)
+{
+    std::vector<Point3D> points(30000);
+    for (size_t i = 0; i < points.size(); ++i) points[i] = {double(i), -double(i), 7};
+    Serio::SerializeOptions options;
+    options.directIO = true;
+    options.syncFile = true;
+    Serio::save<Serio::Binary>(options, TMP_FILE, points, std::string("end"));
+    EXPECT_EQ(file_bytes(TMP_FILE), Serio::serialize<Serio::Binary>({}, points, std::string("end")));
+
+    std::vector<Point3D> out;
+    std::string end;
+    Serio::load<Serio::Binary>({}, TMP_FILE, out, end);
+    EXPECT_EQ(out, points);
+    EXPECT_EQ(end, "end");
+}
+
+#ifdef O_DIRECT
+TEST(BinaryStream, KeepsDirectFlagOfDescriptor)
+{
+    std::vector<double> values(50000, 1.5);
+    int fd = ::open(TMP_FILE, O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0666);
+    if (fd == -1) return;  // Not every file system takes O_DIRECT.
+
+    // The first write ends in an unaligned tail; the second starts at an unaligned offset, so its
+    // aligned blocks are rejected.
+    Serio::write<Serio::Binary>({}, fd, values, std::string("tail"));
+    EXPECT_TRUE(fcntl(fd, F_GETFL) & O_DIRECT);
+    Serio::write<Serio::Binary>({}, fd, values);
+    EXPECT_TRUE(fcntl(fd, F_GETFL) & O_DIRECT);
+    ::close(fd);
+    EXPECT_EQ(file_bytes(TMP_FILE), Serio::serialize<Serio::Binary>({}, values, std::string("tail")) +
+                                        Serio::serialize<Serio::Binary>({}, values));
+}
+#endif
+#endif
+
+// ---- SerializeOptions::mapFile ----
+
+#ifdef SERIO_UNIX
+TEST(BinaryStream, SavesThroughFileMapping)
+{
+    std::vector<Named> named(20000, Named{"name", 9});
+    std::vector<double> doubles(400000, 0.5);
+    for (int mode = 0; mode < 4; ++mode)
+    {
+        Serio::SerializeOptions options;
+        options.mapFile = true;
+        options.presize = mode & 1;
+        options.enableChecksum = mode & 2;
+        options.varint = mode == 3;
+        Serio::save<Serio::Binary>(options, TMP_FILE, named, doubles);
+        EXPECT_EQ(file_bytes(TMP_FILE), Serio::serialize<Serio::Binary>(options, named, doubles));
+
+        std::vector<Named> first;
+        std::vector<double> second;
+        Serio::load<Serio::Binary>({}, TMP_FILE, first, second);
+        EXPECT_EQ(first, named);
+        EXPECT_EQ(second, doubles);
+    }
+}
+
+TEST(BinaryStream, SavesSmallValueThroughFileMapping)
+{
+    Serio::SerializeOptions options;
+    options.mapFile = true;
+    options.syncFile = true;
+    Serio::save<Serio::Binary>(options, TMP_FILE, int8_t(3));
+    EXPECT_EQ(file_bytes(TMP_FILE), Serio::serialize<Serio::Binary>({}, int8_t(3)));
+}
+#endif
+
+// ---- DeserializeOptions::map* ----
+
+#ifdef SERIO_UNIX
+TEST(BinaryStream, LoadsWithMappingHints)
+{
+    std::vector<Named> named(20000, Named{"name", 9});
+    std::vector<int64_t> numbers(300000, -3);
+    Serio::save<Serio::Binary>({}, TMP_FILE, named, numbers, std::string("end"));
+
+    for (Serio::Size release : {0, 1, 4096, 100000})
+    {
+        Serio::DeserializeOptions options;
+        options.mapSequential = true;
+        options.mapWillNeed = true;
+        options.mapPopulate = release % 2 == 1;
+        options.mapHugePages = true;
+        options.mapRelease = release;
+
+        std::vector<Named> first;
+        std::vector<int64_t> second;
+        std::string third;
+        Serio::load<Serio::Binary>(options, TMP_FILE, first, second, third);
+        EXPECT_EQ(first, named);
+        EXPECT_EQ(second, numbers);
+        EXPECT_EQ(third, "end");
+    }
+}
+
+TEST(BinaryStream, ReleasesMappingWithChecksumAndVarint)
+{
+    Serio::SerializeOptions save;
+    save.enableChecksum = true;
+    save.varint = true;
+    std::map<int, std::string> map;
+    for (int i = 0; i < 5000; ++i) map[i * 7] = std::string(i % 50, 'v');
+    Serio::save<Serio::Binary>(save, TMP_FILE, map);
+
+    Serio::DeserializeOptions options;
+    options.mapRelease = 8192;
+    std::map<int, std::string> out;
+    Serio::load<Serio::Binary>(options, TMP_FILE, out);
+    EXPECT_EQ(out, map);
+}
+#endif
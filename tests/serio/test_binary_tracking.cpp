@@ -0,0 +1,170 @@
+#include "common.h"
+
+struct GraphNode
+{
+    std::string name;
+    std::vector<double> weights;
+    std::vector<std::shared_ptr<GraphNode>> children;
+    std::shared_ptr<GraphNode> next;
+    SERIO_REGISTER(name, weights, children, next)
+};
+
+struct Scene
+{
+    std::vector<std::shared_ptr<GraphNode>> roots;
+    std::shared_ptr<const Named> owner;
+    std::unique_ptr<Named> extra;
+    SERIO_REGISTER(roots, owner, extra)
+};
+
+static Serio::SerializeOptions tracking()
+{
+    Serio::SerializeOptions options;
+    options.trackPointers = true;
+    return options;
+}
+
+static std::vector<Serio::SerializeOptions> encodings()
+{
+    std::vector<Serio::SerializeOptions> options(4, tracking());
+    options[1].varint = true;
+    options[2].bigEndian = true;
+    options[3].varint = options[3].bigEndian = options[3].presize = true;
+    return options;
+}
+
+// A scene of `count` roots that all share the same `depth` levels of nodes below them.
+static Scene scene(int count, int depth)
+{
+    auto shared = std::make_shared<GraphNode>(GraphNode{"leaf", std::vector<double>(64, 0.5), {}, nullptr});
+    for (int i = 0; i < depth; ++i)
+        shared = std::make_shared<GraphNode>(GraphNode{"level" + std::to_string(i), {1, 2}, {shared, shared}, nullptr});
+
+    Scene value;
+    for (int i = 0; i < count; ++i)
+        value.roots.push_back(std::make_shared<GraphNode>(GraphNode{"root", {}, {shared}, nullptr}));
+    value.owner = std::make_shared<Named>(Named{"owner", 1});
+    value.extra.reset(new Named{"extra", 2});
+    return value;
+}
+
+// ---- SerializeOptions::trackPointers ----
+
+TEST(BinaryTracking, SharedObjectsWrittenOnce)
+{
+    auto value = scene(50, 4);
+    auto plain = Serio::serialize<Serio::Binary>({}, value);
+    auto tracked = Serio::serialize<Serio::Binary>(tracking(), value);
+    EXPECT_LT(tracked.size() * 10, plain.size());
+    EXPECT_EQ(Serio::serializedSize(tracking(), value), tracked.size());
+}
+
+TEST(BinaryTracking, SharingRestored)
+{
+    auto value = scene(3, 2);
+    for (const auto& options : encodings())
+    {
+        auto bytes = Serio::serialize<Serio::Binary>(options, value);
+        Scene out;
+        Serio::deserialize<Serio::Binary>({}, bytes, out);
+
+        ASSERT_EQ(out.roots.size(), 3u);
+        ASSERT_NE(out.roots[0], out.roots[1]);
+        auto shared = out.roots[0]->children[0];
+        EXPECT_EQ(out.roots[2]->children[0], shared);
+        EXPECT_EQ(shared->children[0], shared->children[1]);
+        EXPECT_EQ(shared->children[0]->children[0]->weights, std::vector<double>(64, 0.5));
+        EXPECT_EQ(*out.owner, *value.owner);
+        EXPECT_EQ(*out.extra, *value.extra);
+    }
+}
+
+TEST(BinaryTracking, SharedAcrossValues)
+{
+    auto named = std::make_shared<Named>(Named{"same", 3});
+    auto bytes = Serio::serialize<Serio::Binary>(tracking(), named, std::make_pair(named, named));
+
+    std::shared_ptr<Named> first;
+    std::pair<std::shared_ptr<Named>, std::shared_ptr<Named>> pair;
+    Serio::deserialize<Serio::Binary>({}, bytes, first, pair);
+    EXPECT_EQ(*first, *named);
+    EXPECT_EQ(pair.first, first);
+    EXPECT_EQ(pair.second, first);
+}
+
+TEST(BinaryTracking, Cycles)
+{
+    auto head = std::make_shared<GraphNode>(GraphNode{"head", {}, {}, nullptr});
+    auto tail = std::make_shared<GraphNode>(GraphNode{"tail", {}, {head}, head});
+    head->next = tail;
+    head->children.push_back(head);
+
+    std::stringstream stream;
+    Serio::write<Serio::Binary>(tracking(), stream, head);
+    head->next.reset();
+    head->children.clear();
+
+    std::shared_ptr<GraphNode> out;
+    Serio::read<Serio::Binary>({}, stream, out);
+    ASSERT_TRUE(out && out->next);
+    EXPECT_EQ(out->name, "head");
+    EXPECT_EQ(out->children[0], out);
+    EXPECT_EQ(out->next->name, "tail");
+    EXPECT_EQ(out->next->next, out);
+    EXPECT_EQ(out->next->children[0], out);
+    out->next.reset();
+    out->children.clear();
+}
+
+TEST(BinaryTracking, NullAndWeakPointers)
+{
+    auto named = std::make_shared<Named>(Named{"weak", 4});
+    std::weak_ptr<Named> weak = named, expired;
+    auto bytes = Serio::serialize<Serio::Binary>(tracking(), std::shared_ptr<Named>(), weak, named, expired);
+
+    std::shared_ptr<Named> null = named, first, second, last = named;
+    Serio::deserialize<Serio::Binary>({}, bytes, null, first, second, last);
+    EXPECT_FALSE(null);
+    EXPECT_EQ(*first, *named);
+    EXPECT_EQ(second, first);
+    EXPECT_FALSE(last);
+}
+
+TEST(BinaryTracking, SkippedObjectsStillReferenced)
+{
+    auto named = std::make_shared<Named>(Named{"skipped", 5});
+    auto bytes = Serio::serialize<Serio::Binary>(tracking(), named, named);
+
+    std::shared_ptr<Named> out;
+    Serio::deserialize<Serio::Binary>({}, bytes, Serio::skip<std::shared_ptr<Named>>(), out);
+    EXPECT_EQ(*out, *named);
+}
+
+TEST(BinaryTracking, OffByDefault)
+{
+    auto named = std::make_shared<Named>(Named{"twice", 6});
+    auto bytes = Serio::serialize<Serio::Binary>({}, named, named);
+    EXPECT_EQ(bytes[2], 0);
+
+    std::shared_ptr<Named> first, second;
+    Serio::deserialize<Serio::Binary>({}, bytes, first, second);
+    EXPECT_EQ(*first, *second);
+    EXPECT_NE(first, second);
+}
+
+TEST(BinaryTracking, InvalidInputThrows)
+{
+    auto bytes = Serio::serialize<Serio::Binary>(tracking(), std::shared_ptr<Named>());
+    bytes.back() = 7;
+    std::shared_ptr<Named> out;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>({}, bytes, out), Serio::Exception);
+
+    auto named = std::make_shared<Named>(Named{"typed", 7});
+    bytes = Serio::serialize<Serio::Binary>(tracking(), named, named);
+    std::shared_ptr<Point3D> other;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>({}, bytes, out, other), Serio::Exception);
+
+    std::vector<std::shared_ptr<Named>> values{named};
+    EXPECT_THROW(Serio::serialize<Serio::Binary>(tracking(), Serio::indexed(values)), Serio::Exception);
+    EXPECT_THROW(Serio::serialize<Serio::Flat>(tracking(), *named), Serio::Exception);
+}
@@ -0,0 +1,148 @@
+#include "common.h"
+
+enum class Channel : int16_t
+{
+    Red = 1,
+    Green = -2,
+    Blue = 300,
+};
+
+struct Quote
+{
+    int64_t time{};
+    double price{};
+    int32_t size{};
+    float weight{};
+    bool operator==(const Quote& o) const
+    {
+        return time == o.time && price == o.price && size == o.size && weight == o.weight;
+    }
+    SERIO_REGISTER(time, price, size, weight)
+};
+SERIO_TRIVIAL(Quote)
+
+// Same members as Quote, serialized field by field.
+struct SlowQuote
+{
+    int64_t time{};
+    double price{};
+    int32_t size{};
+    float weight{};
+    SERIO_REGISTER(time, price, size, weight)
+};
+
+struct Rgb
+{
+    uint8_t r{}, g{}, b{};
+    bool operator==(const Rgb& o) const { return r == o.r && g == o.g && b == o.b; }
+};
+SERIO_TRIVIAL(Rgb)
+
+namespace Serio
+{
+template <>
+struct CustomClass<Rgb>
+{
+    template <typename S>
+    void serialize(const Rgb& v, S& C)
+    {
+        C.process(v.r, v.g, v.b);
+    }
+    template <typename D>
+    void deserialize(Rgb& v, D& C)
+    {
+        C.process(v.r, v.g, v.b);
+    }
+};
+}  // namespace Serio
+
+// ---- Serio::IsTriviallySerializable ----
+
+TEST(BinaryTrivial, Defaults)
+{
+    static_assert(Serio::IsTriviallySerializable<Channel>::value, "");
+    static_assert(Serio::IsTriviallySerializable<std::complex<float>>::value, "");
+    static_assert(!Serio::IsTriviallySerializable<Point2D>::value, "");
+    static_assert(!Serio::IsTriviallySerializable<std::string>::value, "");
+    static_assert(Serio::IsTriviallySerializable<Quote>::value, "");
+    static_assert(Serio::Impl::IsContinuous<std::vector<Quote>>::value, "");
+    static_assert(Serio::Impl::IsContinuous<std::vector<Channel>>::value, "");
+    static_assert(!Serio::Impl::IsContinuous<std::vector<Point2D>>::value, "");
+}
+
+// ---- Bulk containers ----
+
+TEST(BinaryTrivial, SameBytesAsFieldByField)
+{
+    std::vector<Quote> quotes;
+    std::vector<SlowQuote> slow;
+    for (int i = 0; i < 100; ++i)
+    {
+        quotes.push_back({i, i * 0.5, -i, float(i) / 3});
+        slow.push_back({i, i * 0.5, -i, float(i) / 3});
+    }
+    EXPECT_EQ(Serio::serialize<Serio::Binary>({}, quotes), Serio::serialize<Serio::Binary>({}, slow));
+}
+
+TEST(BinaryTrivial, VectorRoundtrip)
+{
+    std::vector<Quote> quotes(1000);
+    for (size_t i = 0; i < quotes.size(); ++i) quotes[i] = {int64_t(i), 1.0 / (i + 1), int32_t(i * 7), 0.25f};
+    check_bin(quotes);
+}
+
+TEST(BinaryTrivial, ArrayRoundtrip)
+{
+    std::array<Quote, 3> quotes{{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}}};
+    check_bin(quotes);
+}
+
+TEST(BinaryTrivial, Enums)
+{
+    std::vector<Channel> channels{Channel::Red, Channel::Green, Channel::Blue};
+    std::string expected;
+    Serio::Impl::Serializer(expected).process(Serio::Size(3), Channel::Red, Channel::Green, Channel::Blue);
+
+    std::string bytes;
+    Serio::Impl::Serializer(bytes).process(channels);
+    EXPECT_EQ(bytes, expected);
+    check_bin(channels);
+}
+
+TEST(BinaryTrivial, Complex)
+{
+    std::vector<std::complex<double>> values{{1, 2}, {-3, 4.5}, {0, -1}};
+    check_bin(values);
+}
+
+TEST(BinaryTrivial, CustomClassType)
+{
+    std::vector<Rgb> pixels{{1, 2, 3}, {4, 5, 6}};
+    check_bin(pixels);
+    EXPECT_EQ(Serio::serialize<Serio::Binary>({}, pixels).size(), 4 + 8 + 6u);
+}
+
+TEST(BinaryTrivial, StaticArrayView)
+{
+    Quote source[2] = {{1, 2, 3, 4}, {5, 6, 7, 8}};
+    auto bytes = Serio::serialize<Serio::Binary>({}, Serio::StaticArrayView<Quote, 2>(source));
+
+    Quote target[2];
+    Serio::deserialize<Serio::Binary>({}, bytes, Serio::StaticArrayView<Quote, 2>(target));
+    EXPECT_EQ(target[0], source[0]);
+    EXPECT_EQ(target[1], source[1]);
+}
+
+TEST(BinaryTrivial, TruncatedThrows)
+{
+    auto bytes = Serio::serialize<Serio::Binary>({}, std::vector<Quote>(10));
+    bytes.resize(bytes.size() - 1);
+    std::vector<Quote> out;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>({}, bytes, out), Serio::Exception);
+}
+
+TEST(BinaryTrivial, SerializedSize)
+{
+    std::vector<Quote> quotes(25);
+    EXPECT_EQ(Serio::serializedSize({}, quotes), Serio::serialize<Serio::Binary>({}, quotes).size());
+}
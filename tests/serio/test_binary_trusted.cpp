@@ -0,0 +1,162 @@
+#include "common.h"
+
+struct Replica
+{
+    std::vector<Nested> rows;
+    std::map<std::string, std::vector<double>> series;
+    std::vector<bool> flags;
+    std::bitset<12> mask;
+    std::shared_ptr<Named> owner;
+    std::string note;
+    bool operator==(const Replica& o) const
+    {
+        bool owners = owner ? o.owner && *owner == *o.owner : !o.owner;
+        return rows == o.rows && series == o.series && flags == o.flags && mask == o.mask && owners && note == o.note;
+    }
+    SERIO_REGISTER(rows, series, flags, mask, owner, note)
+};
+
+struct Tagged
+{
+    int x = 0;
+    std::string s;
+    std::string blob;
+    bool operator==(const Tagged& o) const { return x == o.x && s == o.s && blob == o.blob; }
+    SERIO_REGISTER(Serio::nvp("x", x), s, Serio::binaryString(blob))
+};
+
+static Replica replica()
+{
+    Replica value;
+    value.rows = {{{1, 2}, {3, 4, 5}, "first"}, {{6, 7}, {}, "second"}};
+    value.series = {{"a", {1.5, 2.5}}, {"b", std::vector<double>(100, 0.25)}};
+    value.flags = {true, false, true, true, false, false, true, false, true};
+    value.mask = 0xABC;
+    value.owner = std::make_shared<Named>(Named{"owner", 3});
+    value.note = "replicated";
+    return value;
+}
+
+static std::vector<Serio::SerializeOptions> encodings()
+{
+    std::vector<Serio::SerializeOptions> options(4);
+    options[1].varint = true;
+    options[2].bigEndian = options[2].enableChecksum = true;
+    options[3].varint = options[3].trackPointers = true;
+    return options;
+}
+
+static Serio::DeserializeOptions trusted()
+{
+    Serio::DeserializeOptions options;
+    options.trusted = true;
+    return options;
+}
+
+// ---- Serio::validate ----
+
+TEST(BinaryValidate, AcceptsWellFormedData)
+{
+    for (const auto& options : encodings())
+    {
+        auto bytes = Serio::serialize<Serio::Binary>(options, replica(), std::string("tail"), 42);
+        EXPECT_TRUE((Serio::validate<Serio::Binary, Replica, std::string, int>({}, bytes)));
+        EXPECT_TRUE((Serio::validate<Serio::Binary, Replica>({}, bytes)));
+    }
+}
+
+TEST(BinaryValidate, RejectsTruncatedData)
+{
+    for (const auto& options : encodings())
+    {
+        auto bytes = Serio::serialize<Serio::Binary>(options, replica(), std::string("tail"));
+        for (Serio::Size size = 0; size < bytes.size(); ++size)
+        {
+            std::string truncated = bytes.substr(0, size);
+            EXPECT_FALSE((Serio::validate<Serio::Binary, Replica, std::string>({}, truncated))) << size;
+        }
+    }
+}
+
+TEST(BinaryValidate, RejectsCorruptLengthsAndChecksums)
+{
+    auto bytes = Serio::serialize<Serio::Binary>({}, std::vector<std::string>{"abc", "de"});
+    bytes[4 + 8] = char(0x7F);
+    EXPECT_FALSE((Serio::validate<Serio::Binary, std::vector<std::string>>({}, bytes)));
+
+    Serio::SerializeOptions checksum;
+    checksum.enableChecksum = true;
+    bytes = Serio::serialize<Serio::Binary>(checksum, replica());
+    bytes.back() ^= 1;
+    EXPECT_FALSE((Serio::validate<Serio::Binary, Replica>({}, bytes)));
+
+    bytes = Serio::serialize<Serio::Binary>({}, std::vector<int>(10, 1));
+    Serio::DeserializeOptions limit;
+    limit.maxLength = 5;
+    EXPECT_TRUE((Serio::validate<Serio::Binary, std::vector<int>>({}, bytes)));
+    EXPECT_FALSE((Serio::validate<Serio::Binary, std::vector<int>>(limit, bytes)));
+}
+
+TEST(BinaryValidate, NamedAndBinaryMembers)
+{
+    Tagged value{5, "text", std::string("\0\x7F", 2)};
+    auto bytes = Serio::serialize<Serio::Binary>({}, value);
+    EXPECT_TRUE((Serio::validate<Serio::Binary, Tagged>({}, bytes)));
+    bytes.pop_back();
+    EXPECT_FALSE((Serio::validate<Serio::Binary, Tagged>({}, bytes)));
+}
+
+// ---- DeserializeOptions::trusted ----
+
+TEST(BinaryTrusted, DecodesSameValues)
+{
+    auto value = replica();
+    for (const auto& options : encodings())
+    {
+        auto bytes = Serio::serialize<Serio::Binary>(options, value, std::string("tail"));
+        ASSERT_TRUE((Serio::validate<Serio::Binary, Replica, std::string>({}, bytes)));
+
+        Replica out;
+        std::string tail;
+        Serio::deserialize<Serio::Binary>(trusted(), bytes, out, tail);
+        EXPECT_EQ(out, value);
+        EXPECT_EQ(tail, "tail");
+    }
+}
+
+TEST(BinaryTrusted, NamedAndBinaryMembers)
+{
+    Tagged value{-3, "named", std::string("\xFF\0\x01", 3)};
+    auto bytes = Serio::serialize<Serio::Binary>({}, value, 9);
+
+    Tagged out;
+    int tail = 0;
+    Serio::deserialize<Serio::Binary>(trusted(), bytes, out, tail);
+    EXPECT_EQ(out, value);
+    EXPECT_EQ(tail, 9);
+    Serio::deserialize<Serio::Binary>(trusted(), bytes, Serio::skip<Tagged>(), tail);
+    EXPECT_EQ(tail, 9);
+}
+
+TEST(BinaryTrusted, ViewsAndSkips)
+{
+    std::vector<int32_t> values{1, 2, 3, 4};
+    auto bytes = Serio::serialize<Serio::Binary>({}, std::string("aligned!"), values, Point3D{1, 2, 3});
+
+    auto options = trusted();
+    options.zeroCopy = true;
+    Serio::PointerView<const int32_t> view;
+    Point3D point;
+    Serio::deserialize<Serio::Binary>(options, bytes, Serio::skip<std::string>(), view, point);
+    ASSERT_EQ(view.size(), 4u);
+    EXPECT_EQ(view[3], 4);
+    EXPECT_EQ(point, (Point3D{1, 2, 3}));
+}
+
+TEST(BinaryTrusted, ChecksStillMadeOnIds)
+{
+    auto bytes = Serio::serialize<Serio::Binary>({}, std::variant<int, std::string>(std::string("text")));
+    bytes[4] = 7;
+    std::variant<int, std::string> out;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>(trusted(), bytes, out), Serio::Exception);
+}
@@ -0,0 +1,169 @@
+#include "common.h"
+
+static Serio::SerializeOptions varint()
+{
+    Serio::SerializeOptions options;
+    options.varint = true;
+    return options;
+}
+
+template <typename T>
+T varint_rt(const T& value)
+{
+    return roundtrip<Serio::Binary>(value, varint());
+}
+
+template <typename T>
+T varint_stream_rt(const T& value)
+{
+    std::stringstream stream;
+    Serio::write<Serio::Binary>(varint(), stream, value);
+    T out{};
+    Serio::read<Serio::Binary>({}, stream, out);
+    return out;
+}
+
+// ---- Serio::Impl::Varint ----
+
+TEST(BinaryVarint, EncodeSizes)
+{
+    using Serio::Impl::Varint;
+    char data[Varint::MaxSize];
+    EXPECT_EQ(Varint::encode(data, 0), 1u);
+    EXPECT_EQ(Varint::encode(data, 127), 1u);
+    EXPECT_EQ(Varint::encode(data, 128), 2u);
+    EXPECT_EQ(Varint::encode(data, 300), 2u);
+    EXPECT_EQ(uint8_t(data[0]), 0xACu);
+    EXPECT_EQ(uint8_t(data[1]), 0x02u);
+    EXPECT_EQ(Varint::encode(data, ~uint64_t(0)), 10u);
+    EXPECT_EQ(Varint::size(~uint64_t(0)), 10u);
+}
+
+TEST(BinaryVarint, DecodeAllLengths)
+{
+    using Serio::Impl::Varint;
+    for (int bits = 0; bits <= 64; ++bits)
+    {
+        uint64_t value = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+        char data[Varint::MaxSize + 8] = {};
+        Serio::Size size = Varint::encode(data, value);
+
+        uint64_t word = 0, byte = 0;
+        EXPECT_EQ(Varint::decode(data, sizeof(data), word), size);
+        EXPECT_EQ(Varint::decode(data, size, byte), size);
+        EXPECT_EQ(word, value);
+        EXPECT_EQ(byte, value);
+    }
+}
+
+TEST(BinaryVarint, DecodeRejectsTruncated)
+{
+    using Serio::Impl::Varint;
+    char data[Varint::MaxSize];
+    uint64_t value;
+    Serio::Size size = Varint::encode(data, 1 << 20);
+    EXPECT_EQ(Varint::decode(data, size - 1, value), 0u);
+}
+
+TEST(BinaryVarint, ZigZag)
+{
+    using Serio::Impl::Varint;
+    EXPECT_EQ(Varint::zigzag(int32_t(0)), 0u);
+    EXPECT_EQ(Varint::zigzag(int32_t(-1)), 1u);
+    EXPECT_EQ(Varint::zigzag(int32_t(1)), 2u);
+    EXPECT_EQ(Varint::zigzag(int64_t(std::numeric_limits<int64_t>::min())), ~uint64_t(0));
+
+    int16_t value;
+    EXPECT_TRUE(Varint::unzigzag(Varint::zigzag(int16_t(-300)), value));
+    EXPECT_EQ(value, -300);
+    EXPECT_FALSE(Varint::unzigzag(Varint::zigzag(int32_t(40000)), value));
+}
+
+// ---- SerializeOptions::varint ----
+
+TEST(BinaryVarint, SetsHeaderFlag)
+{
+    auto bytes = Serio::serialize<Serio::Binary>(varint(), 1);
+    EXPECT_EQ(uint8_t(bytes[2]), uint8_t(Serio::Impl::Flags::Varint));
+}
+
+TEST(BinaryVarint, Integers)
+{
+    EXPECT_EQ(varint_rt(int16_t(-2)), -2);
+    EXPECT_EQ(varint_rt(uint16_t(65535)), 65535);
+    EXPECT_EQ(varint_rt(std::numeric_limits<int32_t>::min()), std::numeric_limits<int32_t>::min());
+    EXPECT_EQ(varint_rt(std::numeric_limits<int64_t>::max()), std::numeric_limits<int64_t>::max());
+    EXPECT_EQ(varint_rt(std::numeric_limits<uint64_t>::max()), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(varint_rt(int8_t(-128)), -128);
+    EXPECT_EQ(varint_rt(true), true);
+    EXPECT_EQ(varint_rt(3.5), 3.5);
+}
+
+TEST(BinaryVarint, SmallValuesShrink)
+{
+    std::map<std::string, int> value{{"a", 1}, {"b", -2}, {"c", 3}};
+    auto fixed = Serio::serialize<Serio::Binary>({}, value);
+    auto small = Serio::serialize<Serio::Binary>(varint(), value);
+    EXPECT_EQ(fixed.size(), 4 + 8 + 3 * (8 + 1 + 4));
+    EXPECT_EQ(small.size(), 4 + 1 + 3 * (1 + 1 + 1));
+}
+
+TEST(BinaryVarint, Containers)
+{
+    std::vector<int32_t> ints{0, -1, 1, 1000000, -1000000};
+    std::vector<double> doubles{1.5, -2.5};
+    std::vector<Named> named{{"x", 1}, {"yy", -2}};
+    std::vector<Point3D> points{{1, 2, 3}, {4, 5, 6}};
+    std::string text(300, 'q');
+    EXPECT_EQ(varint_rt(ints), ints);
+    EXPECT_EQ(varint_rt(doubles), doubles);
+    EXPECT_EQ(varint_rt(named), named);
+    EXPECT_EQ(varint_rt(points), points);
+    EXPECT_EQ(varint_rt(text), text);
+}
+
+TEST(BinaryVarint, Stream)
+{
+    std::vector<Named> named{{"x", 1}, {"yy", -200000}};
+    std::map<int64_t, std::string> map{{-5, "a"}, {1ll << 40, "b"}};
+    EXPECT_EQ(varint_stream_rt(named), named);
+    EXPECT_EQ(varint_stream_rt(map), map);
+}
+
+TEST(BinaryVarint, WithChecksum)
+{
+    auto options = varint();
+    options.enableChecksum = true;
+    std::vector<int> value{1, 2, 3};
+    EXPECT_EQ(roundtrip<Serio::Binary>(value, options), value);
+}
+
+TEST(BinaryVarint, StreamRejectsChecksum)
+{
+    auto options = varint();
+    options.enableChecksum = true;
+    std::stringstream stream(Serio::serialize<Serio::Binary>(options, std::vector<int>{1, 2, 3}));
+    std::vector<int> out;
+    EXPECT_THROW(Serio::read<Serio::Binary>({}, stream, out), Serio::Exception);
+}
+
+TEST(BinaryVarint, SerializedSize)
+{
+    std::vector<Named> value{{"hello", 70000}, {"", -1}};
+    EXPECT_EQ(Serio::serializedSize(varint(), value), Serio::serialize<Serio::Binary>(varint(), value).size());
+}
+
+TEST(BinaryVarint, OutOfRangeThrows)
+{
+    auto bytes = Serio::serialize<Serio::Binary>(varint(), int32_t(70000));
+    int16_t out;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>({}, bytes, out), Serio::Exception);
+}
+
+TEST(BinaryVarint, TruncatedThrows)
+{
+    auto bytes = Serio::serialize<Serio::Binary>(varint(), uint64_t(1) << 40);
+    bytes.pop_back();
+    uint64_t out;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>({}, bytes, out), Serio::Exception);
+}
@@ -156,3 +156,212 @@ TEST(BinaryPointerView, SameAsVector)
     auto b2 = Serio::serialize<Serio::Binary>({}, src);
     EXPECT_EQ(b1, b2);
 }
+
+// ---- DeserializeOptions::zeroCopy ----
+
+static Serio::DeserializeOptions zeroCopy()
+{
+    Serio::DeserializeOptions options;
+    options.zeroCopy = true;
+    return options;
+}
+
+static bool inside(const void* ptr, const std::string& bytes)
+{
+    auto p = static_cast<const char*>(ptr);
+    return p >= bytes.data() && p < bytes.data() + bytes.size();
+}
+
+TEST(BinaryZeroCopy, StringViewPointsIntoInput)
+{
+    auto bytes = Serio::serialize<Serio::Binary>({}, std::string("hello"), std::string(), 7);
+    std::string_view first, second;
+    int tail = 0;
+    Serio::deserialize<Serio::Binary>(zeroCopy(), bytes, first, second, tail);
+    EXPECT_EQ(first, "hello");
+    EXPECT_TRUE(inside(first.data(), bytes));
+    EXPECT_TRUE(second.empty());
+    EXPECT_EQ(tail, 7);
+}
+
+TEST(BinaryZeroCopy, SpanAndPointerViewPointIntoInput)
+{
+    std::vector<int32_t> numbers{1, -2, 3, 40000};
+    std::vector<char> chars{'a', 'b', 'c', 'd'};
+    auto bytes = Serio::serialize<Serio::Binary>({}, numbers, chars, numbers);
+
+    std::span<const int32_t> span;
+    Serio::PointerView<const char> view;
+    Serio::Size length = 0;
+    std::span<const int32_t, 4> fixed(numbers.data(), 4);
+    Serio::deserialize<Serio::Binary>(zeroCopy(), bytes, span, view, length, fixed);
+    ASSERT_EQ(span.size(), numbers.size());
+    EXPECT_TRUE(std::equal(span.begin(), span.end(), numbers.begin()));
+    EXPECT_TRUE(inside(span.data(), bytes));
+    ASSERT_EQ(view.size(), chars.size());
+    EXPECT_EQ(std::string(view.data(), view.size()), "abcd");
+    EXPECT_TRUE(inside(view.data(), bytes));
+    EXPECT_TRUE(std::equal(fixed.begin(), fixed.end(), numbers.begin()));
+    EXPECT_TRUE(inside(fixed.data(), bytes));
+}
+
+TEST(BinaryZeroCopy, NeedsOption)
+{
+    auto bytes = Serio::serialize<Serio::Binary>({}, std::string("hello"));
+    std::string_view view;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>({}, bytes, view), Serio::Exception);
+}
+
+TEST(BinaryZeroCopy, RejectsEncodedElements)
+{
+    std::vector<int32_t> numbers{1, 2, 3};
+    std::span<const int32_t> span;
+
+    Serio::SerializeOptions varint;
+    varint.varint = true;
+    auto bytes = Serio::serialize<Serio::Binary>(varint, numbers);
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>(zeroCopy(), bytes, span), Serio::Exception);
+
+    Serio::SerializeOptions bigEndian;
+    bigEndian.bigEndian = true;
+    bytes = Serio::serialize<Serio::Binary>(bigEndian, numbers);
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>(zeroCopy(), bytes, span), Serio::Exception);
+}
+
+TEST(BinaryZeroCopy, RejectsMisalignedElements)
+{
+    std::vector<int32_t> numbers{1, 2, 3};
+    auto bytes = Serio::serialize<Serio::Binary>({}, char('x'), numbers);
+    char c = 0;
+    std::span<const int32_t> span;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>(zeroCopy(), bytes, c, span), Serio::Exception);
+}
+
+TEST(BinaryZeroCopy, RejectsShortInput)
+{
+    auto bytes = Serio::serialize<Serio::Binary>({}, std::string("hello"));
+    bytes.pop_back();
+    std::string_view view;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>(zeroCopy(), bytes, view), Serio::Exception);
+}
+
+#ifdef SERIO_UNIX
+TEST(BinaryZeroCopy, ViewsIntoFileMapping)
+{
+    std::vector<uint64_t> numbers(10000, 5);
+    Serio::save<Serio::Binary>({}, TMP_FILE, std::string("name"), numbers);
+
+    std::string_view name;
+    std::span<const uint64_t> span;
+    Serio::FileMapping file(TMP_FILE);
+    Serio::deserialize<Serio::Binary>(zeroCopy(), file.view(), name, span);
+    EXPECT_EQ(name, "name");
+    EXPECT_TRUE(std::equal(span.begin(), span.end(), numbers.begin(), numbers.end()));
+
+    std::string owned;
+    EXPECT_THROW(Serio::load<Serio::Binary>(zeroCopy(), TMP_FILE, owned), Serio::Exception);
+}
+#endif
+
+// ---- Serio::indexed / Serio::IndexedView ----
+
+static std::vector<Named> records(int count)
+{
+    std::vector<Named> values;
+    for (int i = 0; i < count; ++i) values.push_back({std::string(i % 7, 'a' + i % 26), i});
+    return values;
+}
+
+TEST(BinaryIndexed, RoundtripsAsVector)
+{
+    auto values = records(100);
+    for (bool varint : {false, true})
+    {
+        Serio::SerializeOptions options;
+        options.varint = varint;
+        auto bytes = Serio::serialize<Serio::Binary>(options, Serio::indexed(values), 7);
+        EXPECT_EQ(bytes.size(), Serio::serializedSize(options, Serio::indexed(values), 7));
+
+        std::vector<Named> out;
+        int tail = 0;
+        Serio::deserialize<Serio::Binary>({}, bytes, Serio::indexed(out), tail);
+        EXPECT_EQ(out, values);
+        EXPECT_EQ(tail, 7);
+    }
+
+    std::stringstream stream;
+    Serio::write<Serio::Binary>({}, stream, Serio::indexed(values));
+    std::vector<Named> out;
+    Serio::read<Serio::Binary>({}, stream, Serio::indexed(out));
+    EXPECT_EQ(out, values);
+}
+
+TEST(BinaryIndexed, ViewDecodesElementsInPlace)
+{
+    auto values = records(1000);
+    for (bool big : {false, true})
+    {
+        Serio::SerializeOptions options;
+        options.varint = big;
+        options.bigEndian = big;
+        auto bytes = Serio::serialize<Serio::Binary>(options, Serio::indexed(values), std::string("end"));
+
+        Serio::IndexedView<Named> view;
+        std::string tail;
+        Serio::deserialize<Serio::Binary>(zeroCopy(), bytes, view, tail);
+        EXPECT_EQ(tail, "end");
+        ASSERT_EQ(view.size(), values.size());
+        EXPECT_EQ(view.at(0), values[0]);
+        EXPECT_EQ(view.at(999), values[999]);
+        EXPECT_EQ(view.range(500, 510), std::vector<Named>(values.begin() + 500, values.begin() + 510));
+        EXPECT_TRUE(view.range(3, 3).empty());
+        EXPECT_THROW(view.at(1000), Serio::Exception);
+        EXPECT_THROW(view.range(10, 1001), Serio::Exception);
+    }
+}
+
+TEST(BinaryIndexed, ViewOfFixedSizeElements)
+{
+    std::vector<Point3D> values{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    auto bytes = Serio::serialize<Serio::Binary>({}, Serio::indexed(values));
+    Serio::IndexedView<Point3D> view;
+    Serio::deserialize<Serio::Binary>(zeroCopy(), bytes, view);
+    EXPECT_EQ(view.at(2), values[2]);
+    EXPECT_EQ(view.range(0, 3), values);
+}
+
+TEST(BinaryIndexed, ViewNeedsZeroCopy)
+{
+    auto bytes = Serio::serialize<Serio::Binary>({}, Serio::indexed(records(3)));
+    Serio::IndexedView<Named> view;
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>({}, bytes, view), Serio::Exception);
+
+    bytes.resize(bytes.size() - 1);
+    EXPECT_THROW(Serio::deserialize<Serio::Binary>(zeroCopy(), bytes, view), Serio::Exception);
+}
+
+TEST(BinaryIndexed, ViewInFlatData)
+{
+    auto values = records(50);
+    auto bytes = Serio::serialize<Serio::Flat>({}, Serio::indexed(values));
+    Serio::IndexedView<Named> view;
+    Serio::deserialize<Serio::Flat>(zeroCopy(), bytes, view);
+    EXPECT_EQ(view.at(42), values[42]);
+
+    std::vector<Named> out;
+    Serio::deserialize<Serio::Flat>({}, bytes, Serio::indexed(out));
+    EXPECT_EQ(out, values);
+}
+
+#ifdef SERIO_UNIX
+TEST(BinaryIndexed, ViewIntoFileMapping)
+{
+    auto values = records(20000);
+    Serio::save<Serio::Binary>({}, TMP_FILE, Serio::indexed(values));
+
+    Serio::FileMapping file(TMP_FILE);
+    Serio::IndexedView<Named> view;
+    Serio::deserialize<Serio::Binary>(zeroCopy(), file.view(), view);
+    EXPECT_EQ(view.range(10000, 10100), std::vector<Named>(values.begin() + 10000, values.begin() + 10100));
+}
+#endif
@@ -0,0 +1,252 @@
+#include "common.h"
+
+template <typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    Serio::Size* allocations;
+
+    CountingAllocator(Serio::Size* allocations) : allocations(allocations) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) : allocations(other.allocations)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        ++*allocations;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p, n); }
+
+    bool operator==(const CountingAllocator& other) const { return allocations == other.allocations; }
+    bool operator!=(const CountingAllocator& other) const { return allocations != other.allocations; }
+};
+
+// ---- Serio::Buffer ----
+
+TEST(Buffer, StartsEmpty)
+{
+    Serio::Buffer buffer;
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.size(), 0u);
+    EXPECT_EQ(buffer.capacity(), 0u);
+    EXPECT_EQ(buffer.data(), nullptr);
+}
+
+TEST(Buffer, TakeExtendsSize)
+{
+    Serio::Buffer buffer;
+    char* ptr = buffer.take(3);
+    std::memcpy(ptr, "abc", 3);
+    ptr = buffer.take(2);
+    std::memcpy(ptr, "de", 2);
+    EXPECT_EQ(std::string(buffer.data(), buffer.size()), "abcde");
+}
+
+TEST(Buffer, GrowsGeometrically)
+{
+    Serio::Buffer buffer;
+    Serio::Size reallocations = 0, capacity = 0;
+    for (int i = 0; i < 100000; ++i)
+    {
+        buffer.take(1);
+        if (buffer.capacity() != capacity) ++reallocations, capacity = buffer.capacity();
+    }
+    EXPECT_EQ(buffer.size(), 100000u);
+    EXPECT_LT(reallocations, 20u);
+}
+
+TEST(Buffer, ReserveKeepsContents)
+{
+    Serio::Buffer buffer;
+    buffer.append("hello", 5);
+    buffer.reserve(1 << 20);
+    EXPECT_GE(buffer.capacity(), Serio::Size(1 << 20));
+    EXPECT_EQ(std::string(buffer.data(), buffer.size()), "hello");
+}
+
+TEST(Buffer, ClearKeepsCapacity)
+{
+    Serio::Buffer buffer;
+    buffer.append("hello", 5);
+    auto capacity = buffer.capacity();
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.capacity(), capacity);
+    buffer.reset();
+    EXPECT_EQ(buffer.capacity(), 0u);
+}
+
+TEST(Buffer, CopyAndMove)
+{
+    Serio::Buffer a;
+    a.append("serio", 5);
+    Serio::Buffer b(a);
+    EXPECT_EQ(std::string(b.data(), b.size()), "serio");
+    Serio::Buffer c(std::move(a));
+    EXPECT_EQ(std::string(c.data(), c.size()), "serio");
+    EXPECT_TRUE(a.empty());
+    a = c;
+    EXPECT_EQ(std::string(a.data(), a.size()), "serio");
+    b = std::move(c);
+    EXPECT_EQ(std::string(b.data(), b.size()), "serio");
+}
+
+TEST(Buffer, CustomAllocator)
+{
+    Serio::Size allocations = 0;
+    CountingAllocator<char> allocator(&allocations);
+    Serio::BasicBuffer<CountingAllocator<char>> buffer(allocator);
+    for (int i = 0; i < 1000; ++i) buffer.take(8);
+    EXPECT_GT(allocations, 0u);
+    EXPECT_LT(allocations, 10u);
+}
+
+// ---- Serializing into a buffer ----
+
+TEST(Buffer, SerializerMatchesString)
+{
+    std::vector<Named> value{{"a", 1}, {"bb", 2}, {"ccc", 3}};
+    std::string expected;
+    Serio::Impl::Serializer(expected).process(value, 42, std::string("tail"));
+
+    Serio::Buffer buffer;
+    Serio::Impl::BufferSerializer<>(buffer).process(value, 42, std::string("tail"));
+    EXPECT_EQ(std::string(buffer.data(), buffer.size()), expected);
+}
+
+TEST(Buffer, SerializerWithCustomAllocator)
+{
+    Serio::Size allocations = 0;
+    Serio::BasicBuffer<CountingAllocator<char>> buffer{CountingAllocator<char>(&allocations)};
+    std::vector<double> value(1000, 1.5);
+    Serio::Impl::BufferSerializer<CountingAllocator<char>>(buffer).process(value);
+    EXPECT_GT(allocations, 0u);
+
+    std::vector<double> out;
+    Serio::Impl::Deserializer(buffer.data(), buffer.size(), 0).process(out);
+    EXPECT_EQ(out, value);
+}
+
+TEST(Buffer, StringSerializerAppends)
+{
+    std::string data = "head";
+    Serio::Impl::Serializer(data).process(uint32_t(7));
+    ASSERT_EQ(data.size(), 8u);
+    EXPECT_EQ(data.substr(0, 4), "head");
+}
+
+// ---- Serio::Segments ----
+
+static std::string gather(const Serio::Segments& segments)
+{
+    std::string output;
+    for (const auto& segment : segments.segments()) output.append(segment.data, segment.size);
+    return output;
+}
+
+TEST(Segments, SmallFieldsAreStaged)
+{
+    std::vector<Named> value{{"a", 1}, {"bb", 2}};
+    Serio::Segments segments;
+    Serio::Size size = Serio::serializeInto({}, segments, value, 3.5);
+    EXPECT_EQ(segments.count(), 1u);
+    EXPECT_EQ(segments.size(), size);
+    EXPECT_EQ(gather(segments), Serio::serialize<Serio::Binary>({}, value, 3.5));
+}
+
+TEST(Segments, LargeBlocksAreReferenced)
+{
+    std::vector<float> tensor(10000, 0.5f);
+    std::string text(5000, 't');
+    Serio::Segments segments;
+    Serio::serializeInto({}, segments, tensor, 7, text);
+
+    auto list = segments.segments();
+    ASSERT_EQ(list.size(), 4u);
+    EXPECT_EQ(list[1].data, (const char*)tensor.data());
+    EXPECT_EQ(list[1].size, tensor.size() * sizeof(float));
+    EXPECT_EQ(list[3].data, text.data());
+    EXPECT_EQ(gather(segments), Serio::serialize<Serio::Binary>({}, tensor, 7, text));
+}
+
+TEST(Segments, Threshold)
+{
+    std::vector<int32_t> value(100, 1);
+    Serio::Segments segments(64);
+    Serio::serializeInto({}, segments, value);
+    EXPECT_EQ(segments.count(), 2u);
+
+    Serio::Segments copied(1 << 20);
+    Serio::serializeInto({}, copied, value);
+    EXPECT_EQ(copied.count(), 1u);
+}
+
+TEST(Segments, WithOptions)
+{
+    std::vector<double> value(2000, 2.5);
+    for (int i = 0; i < 4; ++i)
+    {
+        Serio::SerializeOptions sopt;
+        sopt.enableChecksum = i & 1;
+        sopt.varint = i & 2;
+        Serio::Segments segments;
+        Serio::serializeInto(sopt, segments, value, std::string("x"));
+        auto bytes = gather(segments);
+        EXPECT_EQ(bytes, Serio::serialize<Serio::Binary>(sopt, value, std::string("x")));
+
+        std::vector<double> out;
+        Serio::deserialize<Serio::Binary>({}, bytes, out);
+        EXPECT_EQ(out, value);
+    }
+}
+
+TEST(Segments, AppendsAndClears)
+{
+    std::vector<char> blob(8192, 'b');
+    Serio::Segments segments;
+    Serio::Size first = Serio::serializeInto({}, segments, blob);
+    Serio::Size second = Serio::serializeInto({}, segments, blob);
+    EXPECT_EQ(segments.size(), first + second);
+    EXPECT_EQ(gather(segments), Serio::serialize<Serio::Binary>({}, blob) + Serio::serialize<Serio::Binary>({}, blob));
+
+    segments.clear();
+    EXPECT_EQ(segments.count(), 0u);
+    EXPECT_EQ(segments.size(), 0u);
+}
+
+TEST(Segments, LongPath)
+{
+    std::filesystem::path path = "/data/" + std::string(100, 'p') + "/file.bin";
+    Serio::Segments segments(8);
+    Serio::serializeInto({}, segments, path, 5);
+    auto bytes = gather(segments);
+    EXPECT_EQ(bytes, Serio::serialize<Serio::Binary>({}, path, 5));
+
+    std::filesystem::path out;
+    int tail = 0;
+    Serio::deserialize<Serio::Binary>({}, bytes, out, tail);
+    EXPECT_EQ(out, path);
+    EXPECT_EQ(tail, 5);
+}
+
+#ifdef SERIO_UNIX
+TEST(Segments, Writev)
+{
+    std::vector<double> value(50000, 4.25);
+    Serio::Segments segments;
+    Serio::serializeInto({}, segments, value);
+
+    auto iov = segments.iovecs();
+    int fd = ::open(TMP_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ASSERT_NE(fd, -1);
+    EXPECT_EQ(::writev(fd, iov.data(), int(iov.size())), ssize_t(segments.size()));
+    ::close(fd);
+
+    std::vector<double> out;
+    Serio::load<Serio::Binary>({}, TMP_FILE, out);
+    EXPECT_EQ(out, value);
+}
+#endif
@@ -221,6 +221,30 @@ TEST(Options, EncryptStringPassword)
 
 #endif
 
+// ---- presize ----
+
+TEST(Options, PresizeRoundtrip)
+{
+    Serio::SerializeOptions sopt;
+    sopt.presize = true;
+    std::vector<Named> orig{{"one", 1}, {"two", 2}, {"three", 3}};
+    auto bytes = Serio::serialize<Serio::Binary>(sopt, orig);
+    EXPECT_EQ(bytes, Serio::serialize<Serio::Binary>({}, orig));
+    std::vector<Named> out;
+    Serio::deserialize<Serio::Binary>({}, bytes, out);
+    EXPECT_EQ(out, orig);
+}
+
+TEST(Options, PresizeAllocatesExactly)
+{
+    Serio::SerializeOptions sopt;
+    sopt.presize = true;
+    std::vector<float> orig(100000, 1.5f);
+    auto bytes = Serio::serialize<Serio::Binary>(sopt, orig);
+    EXPECT_EQ(bytes.size(), Serio::serializedSize({}, orig));
+    EXPECT_LE(bytes.capacity(), bytes.size() + 32);
+}
+
 // ---- maxLength ----
 
 TEST(Options, MaxLengthAccepted)